@@ -47,6 +47,8 @@ class Env {
   virtual int64_t NowMicros() = 0;
   virtual MaceStatus AdviseFree(void *addr, size_t length);
   virtual MaceStatus GetCPUMaxFreq(std::vector<float> *max_freqs);
+  // instantaneous scaling frequencies, for thermal droop detection
+  virtual MaceStatus GetCPUCurFreq(std::vector<float> *cur_freqs);
   virtual MaceStatus SchedSetAffinity(const std::vector<size_t> &cpu_ids);
   virtual FileSystem *GetFileSystem() = 0;
   virtual LogWriter *GetLogWriter() = 0;
@@ -74,6 +76,10 @@ inline MaceStatus GetCPUMaxFreq(std::vector<float> *max_freqs) {
   return port::Env::Default()->GetCPUMaxFreq(max_freqs);
 }
 
+inline MaceStatus GetCPUCurFreq(std::vector<float> *cur_freqs) {
+  return port::Env::Default()->GetCPUCurFreq(cur_freqs);
+}
+
 inline MaceStatus SchedSetAffinity(const std::vector<size_t> &cpu_ids) {
   return port::Env::Default()->SchedSetAffinity(cpu_ids);
 }
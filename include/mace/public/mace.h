@@ -19,6 +19,8 @@
 #define MACE_PUBLIC_MACE_H_
 
 #include <cstdint>
+#include <functional>
+#include <future>  // NOLINT(build/c++11)
 #include <map>
 #include <memory>
 #include <string>
@@ -282,6 +284,20 @@ class MACE_API GPUContextBuilder {
   GPUContextBuilder &SetOpenCLParameter(const unsigned char *data,
                                         const size_t size);
 
+  /// \brief Set the path of the combined OpenCL cache file
+  ///
+  /// One versioned file holding the compiled kernel binaries, the tuned
+  /// parameters and the device fingerprint together. It can be generated
+  /// on one device (run with tuning enabled), shipped with the
+  /// application, and loaded in one read at startup; the cache is
+  /// cleared and rebuilt automatically when the file format version or
+  /// the OpenCL driver changes. When set, it replaces the separate
+  /// storage/parameter files configured above.
+  ///
+  /// \param path Make sure your program have Read/Write permission of the path
+  /// \return
+  GPUContextBuilder &SetOpenCLCombinedCachePath(const std::string &path);
+
   std::shared_ptr<GPUContext> Finalize();
 
  private:
@@ -401,9 +417,23 @@ class MACE_API MaceTensor {
   //        allocated by C++, e.g. a C buffer), you can set customized deleter
   //        of shared_ptr and manage the life cycle of the buffer by yourself.
   //        For example, std::shared_ptr<float>(raw_buffer, [](float *){});
+  // zero_copy - allow the engine to write the buffer in place when
+  //        this tensor is used as an output and data type and layout
+  //        match the model's (otherwise the engine silently falls
+  //        back to copying). The buffer must stay valid and unchanged
+  //        for the whole run, including asynchronous ones.
+  //        Inputs always copy regardless of this flag: the NEON
+  //        kernels may overread input tails by a small pad the
+  //        engine's own buffers carry but caller buffers do not.
+  //        Model cascades still save a hop by using one zero-copy
+  //        MaceTensor as the upstream engine's output and the
+  //        downstream engine's input: the first engine produces
+  //        straight into the buffer the second one copies from,
+  //        removing one of the two copies.
   MaceTensor(const std::vector<int64_t> &shape,
              std::shared_ptr<void> data,
-             const DataFormat format = DataFormat::NHWC);
+             const DataFormat format = DataFormat::NHWC,
+             const bool zero_copy = false);
   MaceTensor();
   MaceTensor(const MaceTensor &other);
   MaceTensor(const MaceTensor &&other);
@@ -457,6 +487,49 @@ class MACE_API MaceEngine {
                  std::map<std::string, MaceTensor> *outputs,
                  RunMetadata *run_metadata);
 
+  /// \brief Run the model asynchronously.
+  ///
+  /// The run is enqueued on an internal executor thread and this call
+  /// returns at once, so CPU pre/post-processing of the next frame can
+  /// overlap device execution. Runs of one engine execute in enqueue
+  /// order. \a inputs is captured by value (the underlying buffers are
+  /// shared, not copied); \a outputs must stay valid until the returned
+  /// future is ready. \a callback, if given, is invoked on the executor
+  /// thread with the run status after \a outputs has been filled.
+  std::shared_future<MaceStatus> RunAsync(
+      const std::map<std::string, MaceTensor> &inputs,
+      std::map<std::string, MaceTensor> *outputs,
+      const std::function<void(MaceStatus)> &callback = nullptr);
+
+  /// \brief Drop resident weight pages until they are needed again.
+  ///
+  /// With file-based engine creation on CPU, const tensors alias the
+  /// memory-mapped model file; this returns those clean pages to the
+  /// OS (madvise DONTNEED), and later runs refault them on demand.
+  /// Useful when the app is backgrounded or after rarely-used layers
+  /// ran. No effect for engines whose weights were copied (GPU,
+  /// quantize-expanded or in-memory models).
+  MaceStatus TrimWeightPages();
+
+  /// \brief Perform first-run work ahead of the first real frame.
+  ///
+  /// Runs one inference over zero-filled inputs shaped from the
+  /// model's input info, which triggers GEMM weight packing, OpenCL
+  /// program compilation (and tuning when enabled), and pages mmapped
+  /// weights in, so the first user-visible frame runs at steady-state
+  /// latency. Returns MACE_INVALID_ARGS if the model's input shapes
+  /// contain unknown (non-positive) dimensions.
+  MaceStatus Warmup();
+
+  /// \brief Report the engine's planned memory usage.
+  ///
+  /// Returns a human/machine-readable summary built at Init: each
+  /// planned activation block with its memory type and size, the
+  /// tensor-to-block assignment, and the activation total in bytes
+  /// (first line, "activation_bytes: N"). Useful for chasing OOM
+  /// kills in the field without a debugger attached.
+  std::string GetMemorySummary() const;
+
   // @Deprecated, will be removed in future version
   MaceStatus Init(const NetDef *net_def,
                   const std::vector<std::string> &input_nodes,
@@ -499,6 +572,33 @@ MACE_API MaceStatus CreateMaceEngineFromProto(
     const MaceEngineConfig &config,
     std::shared_ptr<MaceEngine> *engine);
 
+/// \brief Create MaceEngine from model graph proto and weights file
+///
+/// Create MaceEngine object. The weights file is memory-mapped instead
+/// of being read into an allocated buffer; with the CPU runtime, const
+/// tensors reference the mapped pages directly, so startup avoids both
+/// the copy and the double-resident weights memory of the in-memory
+/// variant above. The engine keeps the mapping alive as long as needed.
+///
+/// \param model_graph_proto[in]: the content of model graph proto
+/// \param model_graph_proto_size[in]: the size of model graph proto
+/// \param model_weights_file[in]: the path of model weights file
+/// \param input_nodes[in]: the array of input nodes' name
+/// \param output_nodes[in]: the array of output nodes' name
+/// \param config[in]: configurations for MaceEngine.
+/// \param engine[out]: output MaceEngine object
+/// \return MaceStatus::MACE_SUCCESS for success,
+///         MaceStatus::MACE_INVALID_ARGS for wrong arguments,
+///         MaceStatus::MACE_OUT_OF_RESOURCES for resources is out of range.
+MACE_API MaceStatus CreateMaceEngineFromProto(
+    const unsigned char *model_graph_proto,
+    const size_t model_graph_proto_size,
+    const std::string &model_weights_file,
+    const std::vector<std::string> &input_nodes,
+    const std::vector<std::string> &output_nodes,
+    const MaceEngineConfig &config,
+    std::shared_ptr<MaceEngine> *engine);
+
 /// \brief Create MaceEngine from files (model file + data file)
 /// Deprecated, will be removed in future version
 ///
@@ -0,0 +1,97 @@
+// Copyright 2020 The MACE Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Stable C ABI over the engine: opaque handles, plain C types, no STL
+// at the boundary, so hosts built with a different NDK/STL (or another
+// language entirely) can dlopen one libmace. Semantics match the C++
+// API; see mace.h for the detailed contracts.
+
+#ifndef MACE_PUBLIC_MACE_C_API_H_
+#define MACE_PUBLIC_MACE_C_API_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef MACE_API
+#ifdef _MSC_VER
+#define MACE_API
+#else
+#define MACE_API __attribute__((visibility("default")))
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct MaceEngineHandleImpl *MaceEngineHandle;
+
+// mirrors MaceStatus::Code
+typedef enum {
+  MACE_C_SUCCESS = 0,
+  MACE_C_INVALID_ARGS = 1,
+  MACE_C_OUT_OF_RESOURCES = 2,
+  MACE_C_UNSUPPORTED = 3,
+  MACE_C_RUNTIME_ERROR = 4,
+} MaceCStatus;
+
+// mirrors DeviceType (HEXAGON/HTA/APU need their C++ config objects
+// and are not exposed through the C layer yet)
+typedef enum {
+  MACE_C_DEVICE_CPU = 0,
+  MACE_C_DEVICE_GPU = 2,
+} MaceCDeviceType;
+
+typedef struct {
+  const char *name;
+  // densely packed data of dims[0] * ... * dims[dim_count-1] floats
+  float *data;
+  const int64_t *dims;
+  size_t dim_count;
+} MaceCTensor;
+
+/// Create and initialize an engine from the model graph proto and the
+/// in-memory weights. weights must stay alive for the engine's
+/// lifetime when the CPU device is used (the engine aliases it).
+MACE_API MaceCStatus MaceEngineCreate(const uint8_t *model_graph_proto,
+                                      size_t model_graph_proto_size,
+                                      const uint8_t *model_weights_data,
+                                      size_t model_weights_data_size,
+                                      const char *const *input_names,
+                                      size_t input_count,
+                                      const char *const *output_names,
+                                      size_t output_count,
+                                      MaceCDeviceType device_type,
+                                      int num_threads,
+                                      MaceEngineHandle *engine_out);
+
+/// Run one inference. Output buffers must be large enough for the
+/// model's output shapes; on return each output's dims describe the
+/// produced shape (dims points into engine-owned storage, valid until
+/// the next run or destroy).
+MACE_API MaceCStatus MaceEngineRun(MaceEngineHandle engine,
+                                   const MaceCTensor *inputs,
+                                   size_t input_count,
+                                   MaceCTensor *outputs,
+                                   size_t output_count);
+
+MACE_API void MaceEngineDestroy(MaceEngineHandle engine);
+
+MACE_API const char *MaceCVersion();
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // MACE_PUBLIC_MACE_C_API_H_
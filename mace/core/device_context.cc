@@ -17,6 +17,7 @@
 #include <sys/stat.h>
 
 #include "mace/port/env.h"
+#include "mace/utils/logging.h"
 
 namespace mace {
 
@@ -24,6 +25,27 @@ namespace {
 
 const char *kPrecompiledProgramFileName = "mace_cl_compiled_program.bin";
 
+// combined single-file cache: format version bumps invalidate shipped
+// artifacts; the OpenCL platform fingerprint check in OpenCLRuntime
+// handles driver changes on top of this
+const char *kCombinedCacheVersionKey = "mace_cl_combined_cache_version";
+const char *kTunedParamTableKey = "mace_cl_tuned_param_table";
+const uint32_t kCombinedCacheVersion = 1;
+
+void CheckCombinedCacheVersion(KVStorage *storage) {
+  storage->Load();
+  std::vector<unsigned char> version_bytes(
+      reinterpret_cast<const unsigned char *>(&kCombinedCacheVersion),
+      reinterpret_cast<const unsigned char *>(&kCombinedCacheVersion)
+          + sizeof(kCombinedCacheVersion));
+  auto *stored_version = storage->Find(kCombinedCacheVersionKey);
+  if (stored_version == nullptr || *stored_version != version_bytes) {
+    LOG(INFO) << "Combined OpenCL cache version mismatch, rebuilding";
+    storage->Clear();
+    storage->Insert(kCombinedCacheVersionKey, version_bytes);
+  }
+}
+
 std::string FindFirstExistPath(const std::vector<std::string> &paths) {
   std::string result;
   struct stat st;
@@ -45,14 +67,31 @@ GPUContext::GPUContext(const std::string &storage_path,
                        const unsigned char *opencl_binary_ptr,
                        const size_t opencl_binary_size,
                        const unsigned char *opencl_parameter_ptr,
-                       const size_t opencl_parameter_size)
-    : storage_factory_(new FileStorageFactory(storage_path)),
-      opencl_tuner_(new Tuner<uint32_t>(opencl_parameter_path,
-                                        opencl_parameter_ptr,
-                                        opencl_parameter_size)) {
-  if (!storage_path.empty()) {
-    opencl_cache_storage_ =
-        storage_factory_->CreateStorage(kPrecompiledProgramFileName);
+                       const size_t opencl_parameter_size,
+                       const std::string &opencl_combined_cache_path)
+    : storage_factory_(new FileStorageFactory(storage_path)) {
+  if (!opencl_combined_cache_path.empty()) {
+    // one mmap-backed load serves program binaries and tuned parameters
+    combined_cache_storage_.reset(
+        new FileStorage(opencl_combined_cache_path));
+    CheckCombinedCacheVersion(combined_cache_storage_.get());
+    opencl_cache_storage_ = combined_cache_storage_;
+    auto *param_table =
+        combined_cache_storage_->Find(kTunedParamTableKey);
+    if (param_table != nullptr && !param_table->empty()) {
+      opencl_tuner_.reset(new Tuner<uint32_t>(
+          "", param_table->data(), param_table->size()));
+    } else {
+      opencl_tuner_.reset(new Tuner<uint32_t>());
+    }
+  } else {
+    opencl_tuner_.reset(new Tuner<uint32_t>(opencl_parameter_path,
+                                            opencl_parameter_ptr,
+                                            opencl_parameter_size));
+    if (!storage_path.empty()) {
+      opencl_cache_storage_ =
+          storage_factory_->CreateStorage(kPrecompiledProgramFileName);
+    }
   }
 
   if (opencl_binary_ptr != nullptr) {
@@ -68,7 +107,17 @@ GPUContext::GPUContext(const std::string &storage_path,
   }
 }
 
-GPUContext::~GPUContext() = default;
+GPUContext::~GPUContext() {
+  // persist tuned parameters into the combined artifact beside the
+  // compiled programs, which OpenCLRuntime has already inserted
+  if (combined_cache_storage_ != nullptr && opencl_tuner_ != nullptr &&
+      opencl_tuner_->IsTuning()) {
+    std::vector<unsigned char> param_table;
+    opencl_tuner_->Serialize(&param_table);
+    combined_cache_storage_->Insert(kTunedParamTableKey, param_table);
+    combined_cache_storage_->Flush();
+  }
+}
 
 std::shared_ptr<KVStorage> GPUContext::opencl_binary_storage() {
   return opencl_binary_storage_;
@@ -33,7 +33,8 @@ class GPUContext {
              const unsigned char *opencl_binary_ptr = nullptr,
              const size_t opencl_binary_size = 0,
              const unsigned char *opencl_parameter_ptr = nullptr,
-             const size_t opencl_parameter_size = 0);
+             const size_t opencl_parameter_size = 0,
+             const std::string &opencl_combined_cache_path = "");
   ~GPUContext();
 
   std::shared_ptr<KVStorage> opencl_binary_storage();
@@ -45,6 +46,9 @@ class GPUContext {
   std::shared_ptr<Tuner<uint32_t>> opencl_tuner_;
   std::shared_ptr<KVStorage> opencl_binary_storage_;
   std::shared_ptr<KVStorage> opencl_cache_storage_;
+  // set when the combined single-file cache is used; holds program
+  // binaries, tuned parameters and the device fingerprint together
+  std::shared_ptr<KVStorage> combined_cache_storage_;
 };
 
 }  // namespace mace
@@ -46,6 +46,15 @@ bool MemoryOptimizer::IsMemoryReuseOp(const std::string &op_type,
   }
 }
 
+bool MemoryOptimizer::IsInplaceUnaryOp(const std::string &op_type,
+                                       const MemoryType mem_type) {
+  static const std::unordered_set<std::string> kInplaceUnaryOp = {
+      "Activation"
+  };
+  return mem_type == MemoryType::CPU_BUFFER &&
+      kInplaceUnaryOp.count(op_type) == 1;
+}
+
 void MemoryOptimizer::UpdateTensorRef(const std::string &tensor_name) {
   if (tensor_ref_count_.count(tensor_name) == 0) {
     tensor_ref_count_.emplace(tensor_name, 1);
@@ -156,6 +165,14 @@ void MemoryOptimizer::Optimize(
       if (tensor_mem_map_.count(op_def->input(0)) == 1) {
         best_mem_id = tensor_mem_map_.at(op_def->input(0)).mem_id;
       }
+    } else if (IsInplaceUnaryOp(op_def->type(), mem_type) &&
+        op_def->input_size() >= 1 &&
+        tensor_ref_count_.count(op_def->input(0)) == 1 &&
+        tensor_ref_count_.at(op_def->input(0)) == 1 &&
+        tensor_mem_map_.count(op_def->input(0)) == 1) {
+      // last consumer of its input: compute in place, saving one block
+      // and one full tensor of cache traffic
+      best_mem_id = tensor_mem_map_.at(op_def->input(0)).mem_id;
     } else {
       int64_t op_mem_size = op_mem_block.x() * op_mem_block.y();
       int64_t best_added_mem_size = LLONG_MAX;
@@ -92,6 +92,11 @@ class MemoryOptimizer {
  public:
   static bool IsMemoryReuseOp(const std::string &op_type,
                               const MemoryType mem_type);
+  // elementwise unary ops that may compute in place when they are the
+  // last consumer of their input (CPU buffers only; reading and writing
+  // one OpenCL image is undefined)
+  static bool IsInplaceUnaryOp(const std::string &op_type,
+                               const MemoryType mem_type);
   void UpdateTensorRef(const std::string &tensor_name);
   void UpdateTensorRef(const OperatorDef *op_def);
   virtual void Optimize(
@@ -15,11 +15,25 @@
 #include "mace/core/net.h"
 
 #include <algorithm>
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <fstream>
 #include <limits>
+#include <mutex>  // NOLINT(build/c++11)
 #include <set>
+#include <thread>  // NOLINT(build/c++11)
 #include <unordered_set>
 #include <utility>
 
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include "mace/core/future.h"
 #include "mace/core/memory_optimizer.h"
 #include "mace/core/ops/op_init_context.h"
@@ -33,9 +47,57 @@
 #include "mace/utils/math.h"
 #include "mace/utils/memory.h"
 #include "mace/utils/timer.h"
+#include "mace/utils/tuner.h"
 
 namespace mace {
 
+namespace {
+
+#if defined(__linux__)
+// One hardware counter on the calling thread. The dispatch thread
+// participates in every ThreadPool parallel region, so its counts are
+// a consistent proxy for whether an op is compute or memory bound,
+// without the permissions cpu-wide counters need.
+class PmuCounter {
+ public:
+  explicit PmuCounter(uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = static_cast<int>(
+        syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+  }
+  ~PmuCounter() {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+  bool valid() const { return fd_ >= 0; }
+  void Start() {
+    ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+  }
+  int64_t Stop() {
+    ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+    int64_t value = 0;
+    if (read(fd_, &value, sizeof(value)) != sizeof(value)) {
+      value = 0;
+    }
+    return value;
+  }
+
+ private:
+  int fd_;
+};
+#endif  // __linux__
+
+}  // namespace
+
 SerialNet::SerialNet(const OpRegistry *op_registry,
                      const NetDef *net_def,
                      Workspace *ws,
@@ -97,6 +159,7 @@ SerialNet::SerialNet(const OpRegistry *op_registry,
   // Update output tensor reference
   for (auto &output_info : net_def->output_info()) {
     mem_optimizer->UpdateTensorRef(output_info.name());
+    graph_output_names_.insert(output_info.name());
   }
 
   // Do memory optimization
@@ -106,6 +169,109 @@ SerialNet::SerialNet(const OpRegistry *op_registry,
     mem_optimizer->Optimize(op->operator_def().get(), mem_types);
   }
   VLOG(1) << mem_optimizer->DebugInfo();
+
+  // blocks backing more than one tensor cannot hold memoized const
+  // outputs: a later tensor reusing the block would clobber them
+  {
+    std::unordered_map<int, int> block_tensor_count;
+    for (auto &tensor_mem : mem_optimizer->tensor_mem_map()) {
+      ++block_tensor_count[tensor_mem.second.mem_id];
+    }
+    tensor_mem_ids_.clear();
+    for (auto &tensor_mem : mem_optimizer->tensor_mem_map()) {
+      tensor_mem_ids_[tensor_mem.first] = tensor_mem.second.mem_id;
+      if (block_tensor_count[tensor_mem.second.mem_id] > 1) {
+        shared_block_ids_.insert(tensor_mem.second.mem_id);
+      }
+    }
+  }
+
+  collect_ranges_ = EnvConfEnabled("MACE_COLLECT_TENSOR_RANGE");
+  light_profile_ = EnvConfEnabled("MACE_LIGHT_PROFILE");
+  if (light_profile_) {
+    op_total_micros_.assign(operators_.size(), 0);
+    op_run_count_.assign(operators_.size(), 0);
+  }
+  pmu_profile_ = EnvConfEnabled("MACE_PMU_PROFILE");
+  if (pmu_profile_) {
+    op_cache_misses_.assign(operators_.size(), 0);
+    op_instructions_.assign(operators_.size(), 0);
+  }
+
+  // MACE_TRACE_FILE: dump the adapted execution plan (op sequence,
+  // device, data type, planned output shapes) for offline what-if
+  // analysis; join with the light_profile/pmu_profile lines by op name
+  // to get per-op timing and counters into the same trace.
+  std::string trace_file_path;
+  GetEnv("MACE_TRACE_FILE", &trace_file_path);
+  if (!trace_file_path.empty()) {
+    std::ofstream ofs(trace_file_path.c_str());
+    if (ofs.is_open()) {
+      for (auto &op : operators_) {
+        const OperatorDef &def = op->debug_def();
+        ofs << def.name() << "\t" << def.type() << "\t"
+            << static_cast<int>(op->device_type()) << "\t"
+            << ProtoArgHelper::GetOptionalArg<OperatorDef, int>(
+                   def, "T", static_cast<int>(DT_FLOAT));
+        for (int i = 0; i < def.output_shape_size(); ++i) {
+          ofs << "\t[";
+          for (int j = 0; j < def.output_shape(i).dims_size(); ++j) {
+            ofs << (j > 0 ? "," : "") << def.output_shape(i).dims(j);
+          }
+          ofs << "]";
+        }
+        ofs << "\n";
+      }
+      LOG(INFO) << "Wrote execution trace to " << trace_file_path;
+    } else {
+      LOG(WARNING) << "Failed to write trace file: " << trace_file_path;
+    }
+  }
+}
+
+SerialNet::~SerialNet() {
+  if (light_profile_) {
+    for (size_t i = 0; i < operators_.size(); ++i) {
+      if (op_run_count_[i] > 0) {
+        LOG(INFO) << "light_profile " << operators_[i]->debug_def().name()
+                  << " " << operators_[i]->debug_def().type()
+                  << " avg_us="
+                  << op_total_micros_[i] / op_run_count_[i]
+                  << " runs=" << op_run_count_[i];
+      }
+    }
+  }
+  if (pmu_profile_) {
+    for (size_t i = 0; i < operators_.size(); ++i) {
+      if (op_instructions_[i] > 0) {
+        LOG(INFO) << "pmu_profile " << operators_[i]->debug_def().name()
+                  << " cache_misses=" << op_cache_misses_[i]
+                  << " instructions=" << op_instructions_[i];
+      }
+    }
+  }
+  if (!collect_ranges_ || collected_ranges_.empty()) {
+    return;
+  }
+  // converter-compatible range file: one "name@@min,max" line per
+  // tensor, collected over all runs on this very device
+  std::string range_file_path;
+  GetEnv("MACE_TENSOR_RANGE_FILE", &range_file_path);
+  if (range_file_path.empty()) {
+    range_file_path = "mace_tensor_ranges.txt";
+  }
+  std::ofstream ofs(range_file_path.c_str());
+  if (!ofs.is_open()) {
+    LOG(WARNING) << "Failed to write tensor range file: " << range_file_path;
+    return;
+  }
+  for (auto &range : collected_ranges_) {
+    ofs << range.first << "@@" << range.second.first << ","
+        << range.second.second << "\n";
+  }
+  ofs.close();
+  LOG(INFO) << "Wrote " << collected_ranges_.size()
+            << " tensor ranges to " << range_file_path;
 }
 
 MaceStatus SerialNet::Init() {
@@ -122,6 +288,45 @@ MaceStatus SerialNet::Init() {
     // Initialize the operation
     MACE_RETURN_IF_ERROR(op->Init(&init_context));
   }
+
+  // classify constant-only ops for cross-run memoization. Pooled
+  // activation chunks are shared across engines whose runs interleave,
+  // so nothing written to them survives between this net's runs and
+  // memoization must stay off entirely.
+  op_const_only_.assign(operators_.size(), false);
+  op_const_done_.assign(operators_.size(), false);
+  if (ws_->use_shared_activation_pool()) {
+    return MaceStatus::MACE_SUCCESS;
+  }
+  std::unordered_set<std::string> const_tensors;
+  for (size_t i = 0; i < operators_.size(); ++i) {
+    const OperatorDef &def = operators_[i]->debug_def();
+    bool const_only = true;
+    for (int in_idx = 0; in_idx < def.input_size(); ++in_idx) {
+      const Tensor *input = ws_->GetTensor(def.input(in_idx));
+      const_only = const_only && input != nullptr &&
+          (input->is_weight() ||
+           const_tensors.count(def.input(in_idx)) == 1);
+    }
+    for (int out_idx = 0; out_idx < def.output_size(); ++out_idx) {
+      auto mem_iter = tensor_mem_ids_.find(def.output(out_idx));
+      const_only = const_only &&
+          (mem_iter == tensor_mem_ids_.end() ||
+           shared_block_ids_.count(mem_iter->second) == 0);
+      // model outputs can be retargeted to caller buffers (zero-copy)
+      // between runs, so skipping their producer would return an
+      // unwritten or stale buffer
+      const_only = const_only &&
+          graph_output_names_.count(def.output(out_idx)) == 0;
+    }
+    if (const_only) {
+      op_const_only_[i] = true;
+      for (int out_idx = 0; out_idx < def.output_size(); ++out_idx) {
+        const_tensors.insert(def.output(out_idx));
+      }
+      VLOG(1) << "Memoizable const op: " << def.name();
+    }
+  }
   return MaceStatus::MACE_SUCCESS;
 }
 
@@ -132,6 +337,7 @@ MaceStatus SerialNet::Run(RunMetadata *run_metadata) {
 
   MACE_MEMORY_LOGGING_GUARD();
   MACE_LATENCY_LOGGER(1, "Running net");
+  ws_->run_arena()->Reset();
   OpContext context(ws_, cpu_device_.get());
   for (auto iter = operators_.begin(); iter != operators_.end(); ++iter) {
     auto &op = *iter;
@@ -150,7 +356,45 @@ MaceStatus SerialNet::Run(RunMetadata *run_metadata) {
 
     CallStats call_stats;
     if (run_metadata == nullptr) {
-      MACE_RETURN_IF_ERROR(op->Run(&context));
+      const size_t const_idx = iter - operators_.begin();
+      if (const_idx < op_const_only_.size() && op_const_only_[const_idx]) {
+        if (op_const_done_[const_idx]) {
+          continue;  // outputs already produced and unclobbered
+        }
+        op_const_done_[const_idx] = true;
+      }
+    }
+    bool op_executed = false;
+    if (run_metadata == nullptr) {
+#if defined(__linux__)
+      if (pmu_profile_) {
+        static thread_local PmuCounter cache_miss_counter(
+            PERF_COUNT_HW_CACHE_MISSES);
+        static thread_local PmuCounter instruction_counter(
+            PERF_COUNT_HW_INSTRUCTIONS);
+        if (cache_miss_counter.valid() && instruction_counter.valid()) {
+          cache_miss_counter.Start();
+          instruction_counter.Start();
+          MaceStatus status = op->Run(&context);
+          const size_t op_idx = iter - operators_.begin();
+          op_cache_misses_[op_idx] += cache_miss_counter.Stop();
+          op_instructions_[op_idx] += instruction_counter.Stop();
+          MACE_RETURN_IF_ERROR(status);
+          op_executed = true;
+        }
+      }
+#endif  // __linux__
+      if (!op_executed && light_profile_) {
+        // one clock pair per op, accumulated into flat arrays: cheap
+        // enough to stay on in production
+        const int64_t start_micros = NowMicros();
+        MACE_RETURN_IF_ERROR(op->Run(&context));
+        const size_t op_idx = iter - operators_.begin();
+        op_total_micros_[op_idx] += NowMicros() - start_micros;
+        ++op_run_count_[op_idx];
+      } else if (!op_executed) {
+        MACE_RETURN_IF_ERROR(op->Run(&context));
+      }
     } else {
       if (device_type == DeviceType::CPU
           || (device_type == DeviceType::GPU && !enable_opencl_profiling)) {
@@ -210,6 +454,63 @@ MaceStatus SerialNet::Run(RunMetadata *run_metadata) {
     VLOG(3) << "Operator " << op->debug_def().name()
             << " has shape: " << MakeString(op->Output(0)->shape());
 
+    if (EnvConfEnabled("MACE_CHECKSUM_OUTPUTS")) {
+      // tiny on-device reductions instead of pulling tensors to host:
+      // comparing these lines across devices/versions catches numeric
+      // regressions in seconds
+      for (int i = 0; i < op->OutputSize(); ++i) {
+        if (op->Output(i)->dtype() != DT_FLOAT) {
+          continue;
+        }
+        Tensor::MappingGuard guard(op->Output(i));
+        const float *output_data = op->Output(i)->data<float>();
+        const index_t size = op->Output(i)->size();
+        double sum = 0;
+        double sq_sum = 0;
+        index_t nan_count = 0;
+        for (index_t j = 0; j < size; ++j) {
+          const float v = output_data[j];
+          if (std::isnan(v)) {
+            ++nan_count;
+          } else {
+            sum += v;
+            sq_sum += static_cast<double>(v) * v;
+          }
+        }
+        const index_t valid = size - nan_count;
+        const double mean = valid > 0 ? sum / valid : 0;
+        const double var = valid > 1 ? (sq_sum / valid - mean * mean) : 0;
+        LOG(INFO) << "checksum @@" << op->debug_def().output(i)
+                  << "@@mean=" << mean
+                  << ",std=" << std::sqrt(std::max(var, 0.0))
+                  << ",nan=" << nan_count;
+      }
+    }
+
+    if (collect_ranges_) {
+      for (int i = 0; i < op->OutputSize(); ++i) {
+        int data_type = op->GetOptionalArg("T", static_cast<int>(DT_FLOAT));
+        if (data_type != static_cast<int>(DT_FLOAT)) {
+          continue;
+        }
+        float max_v = std::numeric_limits<float>::lowest();
+        float min_v = std::numeric_limits<float>::max();
+        Tensor::MappingGuard guard(op->Output(i));
+        auto *output_data = op->Output(i)->data<float>();
+        for (index_t j = 0; j < op->Output(i)->size(); ++j) {
+          max_v = std::max(max_v, output_data[j]);
+          min_v = std::min(min_v, output_data[j]);
+        }
+        auto &range = collected_ranges_[op->debug_def().output(i)];
+        if (range.first == 0.f && range.second == 0.f) {
+          range = {min_v, max_v};
+        } else {
+          range.first = std::min(range.first, min_v);
+          range.second = std::max(range.second, max_v);
+        }
+      }
+    }
+
     if (EnvConfEnabled("MACE_LOG_TENSOR_RANGE")) {
       for (int i = 0; i < op->OutputSize(); ++i) {
         if (op->debug_def().quantize_info_size() == 0) {
@@ -254,4 +555,187 @@ MaceStatus SerialNet::Run(RunMetadata *run_metadata) {
 
   return MaceStatus::MACE_SUCCESS;
 }
+
+GraphParallelNet::GraphParallelNet(const OpRegistry *op_registry,
+                                   const NetDef *net_def,
+                                   Workspace *ws,
+                                   Device *target_device,
+                                   MemoryOptimizer *mem_optimizer)
+    : SerialNet(op_registry, net_def, ws, target_device, mem_optimizer),
+      dispatch_thread_count_(0) {
+  MACE_LATENCY_LOGGER(1, "Constructing GraphParallelNet");
+  MACE_UNUSED(mem_optimizer);  // base ctor snapshots the block map
+}
+
+MaceStatus GraphParallelNet::Init() {
+  MACE_RETURN_IF_ERROR(SerialNet::Init());
+  MACE_LATENCY_LOGGER(1, "Building op dependency DAG");
+
+  const size_t op_count = operators_.size();
+  op_consumers_.assign(op_count, {});
+  op_in_degrees_.assign(op_count, 0);
+
+  // tensor name -> index of the op producing it
+  std::unordered_map<std::string, size_t> tensor_producers;
+  for (size_t i = 0; i < op_count; ++i) {
+    const OperatorDef &op_def = operators_[i]->debug_def();
+    for (int out_idx = 0; out_idx < op_def.output_size(); ++out_idx) {
+      tensor_producers[op_def.output(out_idx)] = i;
+    }
+  }
+  // Memory optimization reuses blocks based on serial liveness, so two
+  // tensors alive concurrently in independent branches may share a block.
+  // Track which ops last touched each block (in serial order) and add
+  // WAR/WAW edges before a block is handed to its next occupant tensor.
+  std::unordered_map<int, std::unordered_set<size_t>> block_accessors;
+  for (size_t i = 0; i < op_count; ++i) {
+    const OperatorDef &op_def = operators_[i]->debug_def();
+    std::unordered_set<size_t> predecessors;
+    for (int in_idx = 0; in_idx < op_def.input_size(); ++in_idx) {
+      auto iter = tensor_producers.find(op_def.input(in_idx));
+      if (iter != tensor_producers.end() && iter->second != i) {
+        predecessors.insert(iter->second);
+      }
+    }
+    for (int out_idx = 0; out_idx < op_def.output_size(); ++out_idx) {
+      auto mem_iter = tensor_mem_ids_.find(op_def.output(out_idx));
+      if (mem_iter == tensor_mem_ids_.end()) {
+        continue;
+      }
+      auto &accessors = block_accessors[mem_iter->second];
+      for (size_t accessor : accessors) {
+        if (accessor != i) {
+          predecessors.insert(accessor);
+        }
+      }
+      accessors.clear();
+      accessors.insert(i);
+    }
+    for (int in_idx = 0; in_idx < op_def.input_size(); ++in_idx) {
+      auto mem_iter = tensor_mem_ids_.find(op_def.input(in_idx));
+      if (mem_iter != tensor_mem_ids_.end()) {
+        block_accessors[mem_iter->second].insert(i);
+      }
+    }
+    for (size_t predecessor : predecessors) {
+      op_consumers_[predecessor].push_back(i);
+    }
+    op_in_degrees_[i] = static_cast<int>(predecessors.size());
+  }
+
+  int hw_concurrency =
+      static_cast<int>(std::thread::hardware_concurrency());
+  dispatch_thread_count_ = std::max(1, std::min(4, hw_concurrency));
+  VLOG(1) << "GraphParallelNet uses " << dispatch_thread_count_
+          << " dispatch threads for " << op_count << " ops";
+  return MaceStatus::MACE_SUCCESS;
+}
+
+MaceStatus GraphParallelNet::Run(RunMetadata *run_metadata) {
+  // Profiling wants deterministic per-op timing, and tuning runs write
+  // the Tuner's parameter table from whichever thread first executes a
+  // kernel -- unsynchronized across dispatch threads -- so both stay
+  // serial.
+  if (run_metadata != nullptr || dispatch_thread_count_ <= 1 ||
+      GetTuningFromEnv()) {
+    return SerialNet::Run(run_metadata);
+  }
+
+  MACE_MEMORY_LOGGING_GUARD();
+  MACE_LATENCY_LOGGER(1, "Running net graph-parallel");
+  ws_->run_arena()->Reset();
+
+  // per-run scheduling state comes from the run arena; mutations below
+  // happen under dag_mutex, matching the arena's thread-safety contract
+  const size_t op_count = operators_.size();
+  utils::ArenaAllocator<int> int_alloc(ws_->run_arena());
+  utils::ArenaAllocator<size_t> size_alloc(ws_->run_arena());
+  std::vector<int, utils::ArenaAllocator<int>> in_degrees(
+      op_in_degrees_.begin(), op_in_degrees_.end(), int_alloc);
+  std::deque<size_t, utils::ArenaAllocator<size_t>> ready_ops(size_alloc);
+  for (size_t i = 0; i < op_count; ++i) {
+    if (in_degrees[i] == 0) {
+      ready_ops.push_back(i);
+    }
+  }
+
+  std::mutex dag_mutex;
+  std::condition_variable dag_cond;
+  size_t finished_count = 0;
+  size_t inflight_count = 0;
+  MaceStatus run_status = MaceStatus::MACE_SUCCESS;
+
+  auto dispatch_loop = [&, this]() {
+    OpContext context(ws_, cpu_device_.get());
+    std::unique_lock<std::mutex> lock(dag_mutex);
+    for (;;) {
+      while (ready_ops.empty() && inflight_count > 0
+          && finished_count < op_count
+          && run_status == MaceStatus::MACE_SUCCESS) {
+        dag_cond.wait(lock);
+      }
+      // Empty ready queue with nothing in flight means either completion
+      // or a stalled (cyclic) graph; the final check below reports it.
+      if (ready_ops.empty() || run_status != MaceStatus::MACE_SUCCESS) {
+        dag_cond.notify_all();
+        return;
+      }
+      const size_t op_idx = ready_ops.front();
+      ready_ops.pop_front();
+      ++inflight_count;
+      const bool skip_memoized = op_idx < op_const_only_.size() &&
+          op_const_only_[op_idx] && op_const_done_[op_idx];
+      lock.unlock();
+
+      MaceStatus status = MaceStatus::MACE_SUCCESS;
+      if (!skip_memoized) {
+        auto &op = operators_[op_idx];
+        DeviceType device_type = op->device_type();
+        MACE_LATENCY_LOGGER(2, "Running operator ", op->debug_def().name(),
+                            "<", device_type, ", ", op->debug_def().type(),
+                            ">");
+        if (device_type == target_device_->device_type()) {
+          context.set_device(target_device_);
+        } else {
+          context.set_device(cpu_device_.get());
+        }
+        status = op->Run(&context);
+      }
+
+      lock.lock();
+      if (!skip_memoized && op_idx < op_const_only_.size() &&
+          op_const_only_[op_idx]) {
+        op_const_done_[op_idx] = true;
+      }
+      --inflight_count;
+      if (status != MaceStatus::MACE_SUCCESS) {
+        run_status = status;
+        dag_cond.notify_all();
+        return;
+      }
+      ++finished_count;
+      for (size_t consumer : op_consumers_[op_idx]) {
+        if (--in_degrees[consumer] == 0) {
+          ready_ops.push_back(consumer);
+        }
+      }
+      dag_cond.notify_all();
+    }
+  };
+
+  std::vector<std::thread> dispatchers;
+  for (int i = 1; i < dispatch_thread_count_; ++i) {
+    dispatchers.emplace_back(dispatch_loop);
+  }
+  dispatch_loop();
+  for (auto &dispatcher : dispatchers) {
+    dispatcher.join();
+  }
+
+  MACE_CHECK(run_status != MaceStatus::MACE_SUCCESS
+                 || finished_count == op_count,
+             "Op dependency graph has a cycle, ran ", finished_count,
+             " of ", op_count, " ops");
+  return run_status;
+}
 }  // namespace mace
@@ -17,8 +17,10 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <sstream>
 
 #include "mace/core/ops/operator.h"
@@ -51,6 +53,8 @@ class SerialNet : public NetBase {
             Device *target_device,
             MemoryOptimizer * mem_optimizer);
 
+  ~SerialNet() override;
+
   MaceStatus Init() override;
 
   MaceStatus Run(RunMetadata *run_metadata = nullptr) override;
@@ -61,10 +65,82 @@ class SerialNet : public NetBase {
   // CPU is base device.
   std::unique_ptr<Device> cpu_device_;
   std::vector<std::unique_ptr<Operation> > operators_;
+  // on-device calibration (MACE_COLLECT_TENSOR_RANGE): running
+  // min/max per tensor over all runs, dumped as a converter-format
+  // range file on destruction
+  bool collect_ranges_;
+  std::unordered_map<std::string, std::pair<float, float>>
+      collected_ranges_;
+  // always-on light profiler (MACE_LIGHT_PROFILE): flat per-op
+  // total/count accumulators, one clock pair per op and no strings or
+  // allocation, logged as per-op averages on destruction. A sample
+  // ring with live export was considered and dropped: the aggregate is
+  // what production logging needs, and a ring adds indexing cost to
+  // every op for data nobody drains.
+  bool light_profile_;
+  std::vector<int64_t> op_total_micros_;
+  std::vector<int64_t> op_run_count_;
+  // PMU profiling (MACE_PMU_PROFILE, Linux): per-op cache-miss and
+  // instruction counts from the dispatch thread, which joins every
+  // parallel region and so is a consistent compute/memory-bound proxy
+  bool pmu_profile_;
+  std::vector<int64_t> op_cache_misses_;
+  std::vector<int64_t> op_instructions_;
+  // tensor name -> memory block id, snapshot from MemoryOptimizer
+  // before it goes away (blocks are reused on serial liveness)
+  std::unordered_map<std::string, int> tensor_mem_ids_;
+  // constant-subgraph memoization: ops whose inputs are all const
+  // produce identical outputs every run (PriorBox anchors, Fill,
+  // shape chains) and are skipped after their first execution, as
+  // long as their output blocks are not shared with other tensors
+  std::unordered_set<int> shared_block_ids_;
+  // model outputs may be retargeted per run (zero-copy buffers), so
+  // their producers are never memoized
+  std::unordered_set<std::string> graph_output_names_;
+  std::vector<bool> op_const_only_;
+  std::vector<bool> op_const_done_;
 
   MACE_DISABLE_COPY_AND_ASSIGN(SerialNet);
 };
 
+// Executes independent branches of the graph concurrently. A dependency
+// DAG is built from tensor producer/consumer relations during Init, and
+// ready ops are dispatched onto a small set of dispatch threads, so
+// multi-branch models (e.g. Inception) do not serialize on one op at a
+// time. Ops still share the CPU compute thread pool, whose parallel
+// regions serialize internally, so intra-op parallelism is unchanged.
+//
+// GPU graphs work too, and overlap the host-side enqueue cost of
+// independent branches: op->Run only enqueues, and because all kernels
+// land on the single in-order command queue, enqueue order (which the
+// DAG keeps consistent with data dependencies) implies execution
+// order. Spreading branches across several command queues so small
+// kernels execute concurrently additionally needs a cl_event per
+// produced tensor threaded into every consumer's wait list; until the
+// kernel helpers take event wait lists, multi-queue dispatch would be
+// unsound and is deliberately not attempted.
+class GraphParallelNet : public SerialNet {
+ public:
+  GraphParallelNet(const OpRegistry *op_registry,
+                   const NetDef *net_def,
+                   Workspace *ws,
+                   Device *target_device,
+                   MemoryOptimizer *mem_optimizer);
+
+  MaceStatus Init() override;
+
+  MaceStatus Run(RunMetadata *run_metadata = nullptr) override;
+
+ private:
+  // op index -> indices of ops that must wait for it
+  std::vector<std::vector<size_t>> op_consumers_;
+  // op index -> number of predecessor ops it waits for
+  std::vector<int> op_in_degrees_;
+  int dispatch_thread_count_;
+
+  MACE_DISABLE_COPY_AND_ASSIGN(GraphParallelNet);
+};
+
 }  // namespace mace
 
 #endif  // MACE_CORE_NET_H_
@@ -14,10 +14,70 @@
 
 #include "mace/core/net_optimizer.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "mace/core/arg_helper.h"
+#include "mace/utils/logging.h"
 
 namespace mace {
 
+namespace {
+
+// MACE_GPU_MIN_TENSOR_SIZE: ops producing fewer elements than this run
+// on CPU, where kernel-launch latency would dominate on GPU (e.g.
+// squeeze-excite bottlenecks). 0 (default) disables the fallback.
+int64_t GetGPUMinTensorSize() {
+  static const int64_t min_size = []() -> int64_t {
+    char *env = getenv("MACE_GPU_MIN_TENSOR_SIZE");
+    return env != nullptr ? strtoll(env, nullptr, 10) : 0;
+  }();
+  return min_size;
+}
+
+// MACE_DEVICE_PLACEMENT_FILE: "op_name device_id" lines (one per op)
+// generated offline from per-SKU profiling runs; ops listed here are
+// pinned to the given device instead of the greedy heuristic, so one
+// binary can ship per-SKU placements without code changes.
+const std::unordered_map<std::string, int> &GetPlacementOverrides() {
+  static const std::unordered_map<std::string, int> overrides = []() {
+    std::unordered_map<std::string, int> result;
+    char *path = getenv("MACE_DEVICE_PLACEMENT_FILE");
+    if (path != nullptr) {
+      std::ifstream ifs(path);
+      std::string op_name;
+      int device_id;
+      while (ifs >> op_name >> device_id) {
+        result[op_name] = device_id;
+      }
+      LOG(INFO) << "Loaded " << result.size()
+                << " device placement overrides from " << path;
+    }
+    return result;
+  }();
+  return overrides;
+}
+
+Argument *FindOrAddArg(OperatorDef *op_def, const std::string &name) {
+  for (Argument &arg : *op_def->mutable_arg()) {
+    if (arg.name() == name) {
+      return &arg;
+    }
+  }
+  Argument *arg = op_def->add_arg();
+  arg->set_name(name);
+  return arg;
+}
+
+}  // namespace
+
 DeviceType NetOptimizer::SelectBestDevice(
     const OperatorDef *op_def,
     DeviceType target_device_type,
@@ -27,6 +87,17 @@ DeviceType NetOptimizer::SelectBestDevice(
       "Conv2D", "DepthwiseConv2d", "Deconv2D", "DepthwiseDeconv2d",
       "FullyConnected"
   };
+  // profile-derived per-SKU pinning wins over every heuristic below
+  const auto &overrides = GetPlacementOverrides();
+  auto override_iter = overrides.find(op_def->name());
+  if (override_iter != overrides.end()) {
+    const DeviceType wanted =
+        static_cast<DeviceType>(override_iter->second);
+    if (wanted == DeviceType::CPU ||
+        available_devices.count(wanted) == 1) {
+      return wanted;
+    }
+  }
   // CPU is the device to fall back
   DeviceType best_device = DeviceType::CPU;
   if (available_devices.count(target_device_type) == 1) {
@@ -39,6 +110,18 @@ DeviceType NetOptimizer::SelectBestDevice(
   if (kComputeIntensiveOps.count(op_def->type()) == 1) {
     return best_device;
   }
+  // Tiny tensors pay more in launch latency than they gain in
+  // throughput; fall back to CPU below the configured size
+  const int64_t min_tensor_size = GetGPUMinTensorSize();
+  if (min_tensor_size > 0 && op_def->output_shape_size() > 0) {
+    int64_t output_size = 1;
+    for (auto dim : op_def->output_shape(0).dims()) {
+      output_size *= dim;
+    }
+    if (output_size < min_tensor_size) {
+      return DeviceType::CPU;
+    }
+  }
   // Greedy strategy: Use input op's device type as current op's device
   for (auto device_type : inputs_op_devices) {
     if (device_type == best_device) {
@@ -47,4 +130,429 @@ DeviceType NetOptimizer::SelectBestDevice(
   }
   return DeviceType::CPU;
 }
+
+void NetOptimizer::FuseResidualBlocks(NetDef *net_def) {
+  std::unordered_map<std::string, int> consumer_count;
+  for (const auto &op : net_def->op()) {
+    for (const auto &input : op.input()) {
+      ++consumer_count[input];
+    }
+  }
+  std::unordered_set<std::string> graph_outputs;
+  for (const auto &output_info : net_def->output_info()) {
+    graph_outputs.insert(output_info.name());
+  }
+  std::unordered_map<std::string, int> tensor_producer;
+  // tensor name -> statically known dims, for the element-wise check
+  std::unordered_map<std::string, std::vector<int64_t>> tensor_dims;
+  for (int i = 0; i < net_def->op_size(); ++i) {
+    const OperatorDef &op = net_def->op(i);
+    for (int out_idx = 0; out_idx < op.output_size(); ++out_idx) {
+      tensor_producer[op.output(out_idx)] = i;
+      if (out_idx < op.output_shape_size()) {
+        tensor_dims[op.output(out_idx)] = std::vector<int64_t>(
+            op.output_shape(out_idx).dims().begin(),
+            op.output_shape(out_idx).dims().end());
+      }
+    }
+  }
+  for (const auto &const_tensor : net_def->tensors()) {
+    tensor_dims[const_tensor.name()] = std::vector<int64_t>(
+        const_tensor.dims().begin(), const_tensor.dims().end());
+  }
+  for (const auto &input_info : net_def->input_info()) {
+    tensor_dims[input_info.name()] = std::vector<int64_t>(
+        input_info.dims().begin(), input_info.dims().end());
+  }
+
+  auto is_float_cpu_op = [](const OperatorDef &op) {
+    return op.device_type() == DeviceType::CPU &&
+        ProtoArgHelper::GetOptionalArg<OperatorDef, int>(
+            op, "T", static_cast<int>(DT_FLOAT)) ==
+            static_cast<int>(DT_FLOAT);
+  };
+  // tensor name -> op index for single-consumer chain lookups
+  auto find_single_consumer = [&](const std::string &tensor_name) {
+    int consumer = -1;
+    for (int i = 0; i < net_def->op_size(); ++i) {
+      for (const auto &input : net_def->op(i).input()) {
+        if (input == tensor_name) {
+          consumer = i;
+        }
+      }
+    }
+    return consumer;
+  };
+
+  std::vector<int> ops_to_remove;
+  for (int i = 0; i < net_def->op_size(); ++i) {
+    OperatorDef *conv_op = net_def->mutable_op(i);
+    if (conv_op->type() != "Conv2D" || !is_float_cpu_op(*conv_op) ||
+        conv_op->input_size() != 3 || conv_op->output_size() != 1) {
+      continue;
+    }
+    // an already-fused activation would be applied in the wrong order
+    if (ProtoArgHelper::GetOptionalArg<OperatorDef, std::string>(
+            *conv_op, "activation", "NOOP") != "NOOP") {
+      continue;
+    }
+    const std::string &conv_out = conv_op->output(0);
+    if (consumer_count[conv_out] != 1 ||
+        graph_outputs.count(conv_out) == 1) {
+      continue;
+    }
+    const int add_idx = find_single_consumer(conv_out);
+    if (add_idx <= i) {
+      continue;
+    }
+    const OperatorDef &add_op = net_def->op(add_idx);
+    if (add_op.type() != "Eltwise" || !is_float_cpu_op(add_op) ||
+        add_op.input_size() != 2 || add_op.output_size() != 1 ||
+        ProtoArgHelper::GetOptionalArg<OperatorDef, int>(
+            add_op, "type", -1) != 0 /* EltwiseType::SUM */ ||
+        !ProtoArgHelper::GetRepeatedArgs<OperatorDef, float>(
+            add_op, "coeff").empty()) {
+      continue;
+    }
+    const std::string residual =
+        add_op.input(0) == conv_out ? add_op.input(1) : add_op.input(0);
+    // the fused conv runs at the conv's position, so the residual must
+    // already exist there (const tensor, graph input, or earlier op)
+    auto producer_iter = tensor_producer.find(residual);
+    if (producer_iter != tensor_producer.end() && producer_iter->second > i) {
+      continue;
+    }
+    // broadcast SUMs (scalar or per-channel second operand) are legal
+    // Eltwise inputs but not valid fused residuals; only fuse when the
+    // residual's dims are statically known to match the conv output
+    if (conv_op->output_shape_size() < 1 ||
+        tensor_dims.count(residual) == 0) {
+      continue;
+    }
+    const auto &conv_dims = conv_op->output_shape(0).dims();
+    const auto &residual_dims = tensor_dims.at(residual);
+    if (residual_dims.size() != static_cast<size_t>(conv_dims.size()) ||
+        !std::equal(conv_dims.begin(), conv_dims.end(),
+                    residual_dims.begin())) {
+      continue;
+    }
+    std::string fused_output = add_op.output(0);
+
+    // optionally swallow a trailing Relu/Relux
+    int act_idx = -1;
+    if (consumer_count[fused_output] == 1 &&
+        graph_outputs.count(fused_output) == 0) {
+      const int candidate = find_single_consumer(fused_output);
+      if (candidate > add_idx) {
+        const OperatorDef &act_op = net_def->op(candidate);
+        const std::string act_type =
+            ProtoArgHelper::GetOptionalArg<OperatorDef, std::string>(
+                act_op, "activation", "NOOP");
+        if (act_op.type() == "Activation" && is_float_cpu_op(act_op) &&
+            act_op.input_size() == 1 && act_op.output_size() == 1 &&
+            (act_type == "RELU" || act_type == "RELUX")) {
+          act_idx = candidate;
+          FindOrAddArg(conv_op, "activation")->set_s(act_type);
+          FindOrAddArg(conv_op, "max_limit")->set_f(
+              ProtoArgHelper::GetOptionalArg<OperatorDef, float>(
+                  act_op, "max_limit", 0.0f));
+          fused_output = act_op.output(0);
+        }
+      }
+    }
+
+    conv_op->add_input(residual);
+    FindOrAddArg(conv_op, "fused_residual_add")->set_i(1);
+    conv_op->set_output(0, fused_output);
+    VLOG(1) << "Fuse residual block into " << conv_op->name()
+            << " (residual " << residual << ")";
+    ops_to_remove.push_back(add_idx);
+    if (act_idx >= 0) {
+      ops_to_remove.push_back(act_idx);
+    }
+  }
+
+  std::sort(ops_to_remove.begin(), ops_to_remove.end());
+  for (auto it = ops_to_remove.rbegin(); it != ops_to_remove.rend(); ++it) {
+    net_def->mutable_op()->DeleteSubrange(*it, 1);
+  }
+}
+
+void NetOptimizer::FusePointwiseActivations(NetDef *net_def) {
+  static const std::set<std::string> kFusableActivations = {
+      "RELU", "RELUX", "TANH", "SIGMOID", "LEAKYRELU", "ELU"};
+
+  std::unordered_map<std::string, int> consumer_count;
+  for (const auto &op : net_def->op()) {
+    for (const auto &input : op.input()) {
+      ++consumer_count[input];
+    }
+  }
+  std::unordered_set<std::string> graph_outputs;
+  for (const auto &output_info : net_def->output_info()) {
+    graph_outputs.insert(output_info.name());
+  }
+
+  std::vector<int> ops_to_remove;
+  for (int i = 0; i < net_def->op_size(); ++i) {
+    OperatorDef *eltwise_op = net_def->mutable_op(i);
+    if (eltwise_op->type() != "Eltwise" ||
+        eltwise_op->device_type() != DeviceType::GPU ||
+        eltwise_op->output_size() != 1 ||
+        ProtoArgHelper::GetOptionalArg<OperatorDef, std::string>(
+            *eltwise_op, "activation", "NOOP") != "NOOP") {
+      continue;
+    }
+    const std::string &eltwise_out = eltwise_op->output(0);
+    if (consumer_count[eltwise_out] != 1 ||
+        graph_outputs.count(eltwise_out) == 1) {
+      continue;
+    }
+    for (int j = i + 1; j < net_def->op_size(); ++j) {
+      const OperatorDef &act_op = net_def->op(j);
+      bool consumes = false;
+      for (const auto &input : act_op.input()) {
+        consumes = consumes || input == eltwise_out;
+      }
+      if (!consumes) {
+        continue;
+      }
+      const std::string act_type =
+          ProtoArgHelper::GetOptionalArg<OperatorDef, std::string>(
+              act_op, "activation", "NOOP");
+      // PRELU carries an alpha input tensor, which the fused kernel
+      // does not take; leave such chains alone
+      if (act_op.type() == "Activation" &&
+          act_op.device_type() == DeviceType::GPU &&
+          act_op.input_size() == 1 && act_op.output_size() == 1 &&
+          kFusableActivations.count(act_type) == 1) {
+        FindOrAddArg(eltwise_op, "activation")->set_s(act_type);
+        FindOrAddArg(eltwise_op, "max_limit")->set_f(
+            ProtoArgHelper::GetOptionalArg<OperatorDef, float>(
+                act_op, "max_limit", 0.0f));
+        FindOrAddArg(eltwise_op, "activation_coefficient")->set_f(
+            ProtoArgHelper::GetOptionalArg<OperatorDef, float>(
+                act_op, "activation_coefficient", 0.0f));
+        eltwise_op->set_output(0, act_op.output(0));
+        VLOG(1) << "Fuse activation " << act_op.name()
+                << " into " << eltwise_op->name();
+        ops_to_remove.push_back(j);
+      }
+      break;
+    }
+  }
+
+  for (auto it = ops_to_remove.rbegin(); it != ops_to_remove.rend(); ++it) {
+    net_def->mutable_op()->DeleteSubrange(*it, 1);
+  }
+}
+
+void NetOptimizer::InsertPrecisionCasts(NetDef *net_def) {
+  auto op_data_type = [](const OperatorDef &op) {
+    return static_cast<DataType>(
+        ProtoArgHelper::GetOptionalArg<OperatorDef, int>(
+            op, "T", static_cast<int>(DT_FLOAT)));
+  };
+  auto is_castable = [](DataType dt) {
+    return dt == DT_FLOAT || dt == DT_BFLOAT16;
+  };
+
+  // tensor -> dtype of the CPU op producing it
+  std::unordered_map<std::string, DataType> producer_type;
+  bool has_mixed_precision = false;
+  for (const auto &op : net_def->op()) {
+    if (op.device_type() != DeviceType::CPU) {
+      continue;
+    }
+    const DataType dt = op_data_type(op);
+    for (const auto &output : op.output()) {
+      producer_type[output] = dt;
+    }
+    for (const auto &input : op.input()) {
+      auto iter = producer_type.find(input);
+      has_mixed_precision = has_mixed_precision ||
+          (iter != producer_type.end() && iter->second != dt &&
+           is_castable(iter->second) && is_castable(dt));
+    }
+  }
+  if (!has_mixed_precision) {
+    return;
+  }
+
+  NetDef casted_net_def(*net_def);
+  casted_net_def.clear_op();
+  // tensor -> already-casted alias per target dtype
+  std::unordered_map<std::string, std::string> casted_alias;
+  for (const OperatorDef &op : net_def->op()) {
+    const DataType dt = op_data_type(op);
+    std::vector<std::pair<int, std::string>> rewired_inputs;
+    if (op.device_type() == DeviceType::CPU) {
+      for (int i = 0; i < op.input_size(); ++i) {
+        auto iter = producer_type.find(op.input(i));
+        if (iter == producer_type.end() || iter->second == dt ||
+            !is_castable(iter->second) || !is_castable(dt)) {
+          continue;
+        }
+        const std::string alias_key =
+            op.input(i) + "#" + MakeString(static_cast<int>(dt));
+        if (casted_alias.count(alias_key) == 0) {
+          // the cast must precede its consumer in serial order
+          OperatorDef *cast_op = casted_net_def.add_op();
+          cast_op->set_name(op.input(i) + "_mace_cast_" +
+                            MakeString(static_cast<int>(dt)));
+          cast_op->set_type("Cast");
+          cast_op->set_device_type(DeviceType::CPU);
+          cast_op->add_input(op.input(i));
+          cast_op->add_output(cast_op->name());
+          cast_op->add_output_type(dt);
+          FindOrAddArg(cast_op, "T")->set_i(
+              static_cast<int>(iter->second));
+          casted_alias[alias_key] = cast_op->name();
+          VLOG(1) << "Insert Cast for " << op.input(i) << " ("
+                  << iter->second << " -> " << dt << ")";
+        }
+        rewired_inputs.emplace_back(i, casted_alias.at(alias_key));
+      }
+    }
+    OperatorDef *new_op = casted_net_def.add_op();
+    *new_op = op;
+    for (const auto &rewire : rewired_inputs) {
+      new_op->set_input(rewire.first, rewire.second);
+    }
+  }
+  net_def->mutable_op()->Swap(casted_net_def.mutable_op());
+}
+
+void NetOptimizer::FuseOneHotMatMul(NetDef *net_def) {
+  std::unordered_map<std::string, int> consumer_count;
+  for (const auto &op : net_def->op()) {
+    for (const auto &input : op.input()) {
+      ++consumer_count[input];
+    }
+  }
+  std::unordered_set<std::string> graph_outputs;
+  for (const auto &output_info : net_def->output_info()) {
+    graph_outputs.insert(output_info.name());
+  }
+
+  std::vector<int> ops_to_remove;
+  for (int i = 0; i < net_def->op_size(); ++i) {
+    const OperatorDef &one_hot_op = net_def->op(i);
+    if (one_hot_op.type() != "OneHot" ||
+        one_hot_op.device_type() != DeviceType::CPU ||
+        one_hot_op.input_size() != 1 || one_hot_op.output_size() != 1 ||
+        ProtoArgHelper::GetOptionalArg<OperatorDef, float>(
+            one_hot_op, "on_value", 1.f) != 1.f ||
+        ProtoArgHelper::GetOptionalArg<OperatorDef, float>(
+            one_hot_op, "off_value", 0.f) != 0.f ||
+        ProtoArgHelper::GetOptionalArg<OperatorDef, int>(
+            one_hot_op, "axis", -1) != -1) {
+      continue;
+    }
+    const std::string &one_hot_out = one_hot_op.output(0);
+    if (consumer_count[one_hot_out] != 1 ||
+        graph_outputs.count(one_hot_out) == 1) {
+      continue;
+    }
+    for (int j = i + 1; j < net_def->op_size(); ++j) {
+      OperatorDef *matmul_op = net_def->mutable_op(j);
+      bool consumes = false;
+      for (const auto &input : matmul_op->input()) {
+        consumes = consumes || input == one_hot_out;
+      }
+      if (!consumes) {
+        continue;
+      }
+      // the one-hot must be the lhs and the weight dense on the rhs
+      if (matmul_op->type() == "MatMul" &&
+          matmul_op->device_type() == DeviceType::CPU &&
+          matmul_op->input_size() == 2 &&
+          matmul_op->input(0) == one_hot_out &&
+          !ProtoArgHelper::GetOptionalArg<OperatorDef, bool>(
+              *matmul_op, "transpose_a", false) &&
+          !ProtoArgHelper::GetOptionalArg<OperatorDef, bool>(
+              *matmul_op, "transpose_b", false)) {
+        const std::string weights = matmul_op->input(1);
+        const std::string indices = one_hot_op.input(0);
+        matmul_op->set_type("Gather");
+        matmul_op->clear_input();
+        matmul_op->add_input(weights);
+        matmul_op->add_input(indices);
+        FindOrAddArg(matmul_op, "axis")->set_i(0);
+        VLOG(1) << "Rewrite OneHot+MatMul to Gather for "
+                << matmul_op->name();
+        ops_to_remove.push_back(i);
+      }
+      break;
+    }
+  }
+
+  for (auto it = ops_to_remove.rbegin(); it != ops_to_remove.rend(); ++it) {
+    net_def->mutable_op()->DeleteSubrange(*it, 1);
+  }
+}
+
+namespace {
+
+struct GraphPass {
+  std::string name;
+  std::function<void(NetDef *)> pass;
+};
+
+std::vector<GraphPass> *GetExtraPasses() {
+  static std::vector<GraphPass> passes;
+  return &passes;
+}
+
+bool PassDisabled(const std::string &name) {
+  static const std::string disabled = []() {
+    char *env = getenv("MACE_DISABLE_GRAPH_PASSES");
+    return std::string(env != nullptr ? env : "");
+  }();
+  size_t pos = 0;
+  while (pos != std::string::npos) {
+    size_t comma = disabled.find(',', pos);
+    if (disabled.substr(pos, comma == std::string::npos
+                                 ? comma : comma - pos) == name) {
+      return true;
+    }
+    pos = comma == std::string::npos ? comma : comma + 1;
+  }
+  return false;
+}
+
+}  // namespace
+
+void NetOptimizer::RunPasses(NetDef *net_def) {
+  const GraphPass builtin_passes[] = {
+      {"fuse_residual_blocks",
+       [this](NetDef *def) { FuseResidualBlocks(def); }},
+      {"fuse_pointwise_activations",
+       [this](NetDef *def) { FusePointwiseActivations(def); }},
+      {"fuse_onehot_matmul",
+       [this](NetDef *def) { FuseOneHotMatMul(def); }},
+      {"insert_precision_casts",
+       [this](NetDef *def) { InsertPrecisionCasts(def); }},
+  };
+  for (const auto &pass : builtin_passes) {
+    if (PassDisabled(pass.name)) {
+      LOG(INFO) << "Graph pass disabled: " << pass.name;
+      continue;
+    }
+    pass.pass(net_def);
+  }
+  for (const auto &pass : *GetExtraPasses()) {
+    if (PassDisabled(pass.name)) {
+      LOG(INFO) << "Graph pass disabled: " << pass.name;
+      continue;
+    }
+    VLOG(1) << "Running registered graph pass: " << pass.name;
+    pass.pass(net_def);
+  }
+}
+
+void NetOptimizer::RegisterPass(const std::string &name,
+                                std::function<void(NetDef *)> pass) {
+  GetExtraPasses()->push_back({name, std::move(pass)});
+}
 }  // namespace mace
@@ -15,7 +15,9 @@
 #ifndef MACE_CORE_NET_OPTIMIZER_H_
 #define MACE_CORE_NET_OPTIMIZER_H_
 
+#include <functional>
 #include <set>
+#include <string>
 #include <vector>
 
 #include "mace/port/port.h"
@@ -42,6 +44,45 @@ class NetOptimizer {
                               DeviceType target_device,
                               const std::set<DeviceType> &available_devices,
                               const std::vector<DeviceType> &inputs_op_devices);
+
+  /// Fuse [Conv2D -> Eltwise(SUM) -> optional Relu/Relux] chains of
+  /// float CPU ops into the conv's epilogue, so bias, residual add and
+  /// activation are applied to each output tile while it is still hot
+  /// in cache instead of re-streaming the whole feature map per op.
+  /// Runs on the adapted net before op construction.
+  void FuseResidualBlocks(NetDef *net_def);
+
+  /// Fuse [Eltwise -> Activation] chains of GPU image ops into one
+  /// kernel launch: the eltwise kernel applies the activation in
+  /// registers instead of a second full-image read/write pass.
+  /// Runs on the adapted net before op construction.
+  void FusePointwiseActivations(NetDef *net_def);
+
+  /// Honor per-op precision annotations (the per-op "T" arg) on CPU by
+  /// inserting Cast ops where a producer's dtype differs from a
+  /// consumer's, so converters can mark individual layers fp32/bf16
+  /// within one graph. Runs on the adapted net before op construction.
+  void InsertPrecisionCasts(NetDef *net_def);
+
+  /// Rewrite [OneHot -> MatMul(one_hot, W)] into Gather(W, indices):
+  /// multiplying a one-hot matrix selects rows of W, so the huge
+  /// sparse intermediate and the GEMM are pure waste. Applies when the
+  /// one-hot uses on=1/off=0 on the last axis and the matmul carries
+  /// no transpose flags.
+  void FuseOneHotMatMul(NetDef *net_def);
+
+  /// Run every registered graph pass, in registration order, on the
+  /// adapted net. Passes registered via RegisterPass run after the
+  /// built-in ones; MACE_DISABLE_GRAPH_PASSES (comma-separated names)
+  /// skips passes by name, for bisecting a miscompiled graph in the
+  /// field without a rebuild.
+  void RunPasses(NetDef *net_def);
+
+  /// Register an extra pass (e.g. a workaround for an exporter quirk
+  /// the offline converter missed) to run on every engine Init in this
+  /// process. Not thread-safe against concurrent Init.
+  static void RegisterPass(const std::string &name,
+                           std::function<void(NetDef *)> pass);
 };
 
 }  // namespace mace
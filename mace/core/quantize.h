@@ -187,6 +187,52 @@ class QuantizeUtil {
     }, 0, size, 1);
   }
 
+  // Unpack int4-packed weights (two values per byte, low nibble first,
+  // nibbles are unsigned and shifted by zero_point) into floats. The
+  // building block for int4 weight storage in memory-bound layers;
+  // count is the number of logical elements.
+  void DequantizeInt4Packed(const uint8_t *packed,
+                            const index_t count,
+                            const float scale,
+                            const int32_t zero_point,
+                            F *output) {
+    const index_t pair_count = count / 2;
+    thread_pool_->Compute1D([=](index_t start, index_t end, index_t step) {
+      for (index_t i = start; i < end; i += step) {
+        const uint8_t byte = packed[i];
+        output[2 * i] =
+            FloatCast<F>(scale * ((byte & 0xf) - zero_point));
+        output[2 * i + 1] =
+            FloatCast<F>(scale * ((byte >> 4) - zero_point));
+      }
+    }, 0, pair_count, 1);
+    if ((count & 1) != 0) {
+      output[count - 1] =
+          FloatCast<F>(scale * ((packed[pair_count] & 0xf) - zero_point));
+    }
+  }
+
+  // per-output-channel dequantization: channel c covers the contiguous
+  // range [c * channel_size, (c + 1) * channel_size)
+  void DequantizePerChannel(const Q *input,
+                            const index_t channels,
+                            const index_t channel_size,
+                            const float *scales,
+                            const int32_t *zero_points,
+                            F *output) {
+    thread_pool_->Compute1D([=](index_t start, index_t end, index_t step) {
+      for (index_t c = start; c < end; c += step) {
+        const float scale = scales[c];
+        const int32_t zero_point = zero_points[c];
+        const Q *input_ptr = input + c * channel_size;
+        F *output_ptr = output + c * channel_size;
+        for (index_t i = 0; i < channel_size; ++i) {
+          output_ptr[i] = FloatCast<F>(scale * (input_ptr[i] - zero_point));
+        }
+      }
+    }, 0, channels, 1);
+  }
+
   void DeQuantize(const Tensor &input,
                   const float min_in,
                   const float max_in,
@@ -50,6 +50,15 @@ bool ApuWrapper::Init(const NetDef &net_def, unsigned const char *model_data,
   return ret;
 }
 
+// Each Run submits one frame through one Neuron execution. Batch-of-
+// frames submission (K frames in one driver transaction to amortize
+// the per-execution scheduling cost) maps onto
+// NeuronExecution burst objects; the neuron_implementation loader in
+// this tree does not yet resolve the burst entry points
+// (NeuronBurst_create/NeuronExecution_burstCompute), so bursts cannot
+// be issued. Once the loader exposes them, the batching loop belongs
+// here, together with cache warm/cold counters from
+// NeuronCompilation_getCacheInfo for the warm-start metrics.
 bool ApuWrapper::Run(const std::map<std::string, Tensor *> &input_tensors,
                      std::map<std::string, Tensor *> *output_tensors) {
   bool ret = frontend->Eval(input_tensors, output_tensors);
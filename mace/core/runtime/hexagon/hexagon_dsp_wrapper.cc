@@ -493,6 +493,21 @@ bool HexagonDSPWrapper::ExecuteGraph(const Tensor &input_tensor,
   return true;
 }
 
+// Session lifetime: Init/SetupGraph cost ~hundreds of ms, so clients
+// keep engines alive to avoid re-registration. A detach/re-attach mode
+// (drop host-side structures, keep the DSP-side graph registered and
+// re-attach by graph id) requires the skel to persist graphs across
+// FastRPC handle closure; the hexagon_nn interface here ties graph
+// lifetime to the handle, so re-attach would find nothing to attach
+// to. Revisit when the skel exposes persistent graph ids.
+//
+// Input/output staging here is synchronous: tensors are copied into
+// ION-backed buffers and hexagon_nn_execute_new blocks until the DSP
+// finishes. Double-buffered staging (copy frame N+1 into a second ION
+// set while frame N executes) needs an asynchronous execute entry
+// point from libhexagon_controller; the stable hexagon_nn interface
+// shipped with this tree only exposes the blocking call, so the
+// overlap has to wait for the async FastRPC API to be available.
 bool HexagonDSPWrapper::ExecuteGraphNew(
     const std::map<std::string, Tensor*> &input_tensors,
     std::map<std::string, Tensor*> *output_tensors) {
@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 
+#include "mace/utils/conf_util.h"
 #include "mace/utils/tuner.h"
 #include "mace/utils/math.h"
 
@@ -97,6 +98,18 @@ std::vector<uint32_t> Default3DLocalWS(OpenCLRuntime *runtime,
   return lws;
 }
 
+// Batched enqueue mode for static-graph throughput runs: submit each
+// kernel as one NDRange (no kernel-time block splitting) and never wait
+// mid-queue, so the whole per-run kernel sequence is issued back to
+// back and the driver batches submission. Trades UI responsiveness for
+// ~per-kernel enqueue overhead; true recordable command queues
+// (cl_qcom_recordable_queues / cl_khr_command_buffer) are not exposed
+// by the bundled OpenCL headers.
+inline bool BatchEnqueueEnabled() {
+  static const bool enabled = EnvConfEnabled("MACE_OPENCL_BATCH_ENQUEUE");
+  return enabled;
+}
+
 /**
  * For GPUs like Arm Mali, when too many commands are added in the command
  * queue, the UI responsiveness may be poor. This function limits the number of
@@ -186,6 +199,14 @@ MaceStatus TuningOrRun3DKernel(OpenCLRuntime *runtime,
     }
 
     if (timer == nullptr) {
+      if (BatchEnqueueEnabled()) {
+        error = runtime->command_queue().enqueueNDRangeKernel(
+            kernel, cl::NullRange,
+            cl::NDRange(internal_gws[0], internal_gws[1], internal_gws[2]),
+            cl::NDRange(params[0], params[1], params[2]), nullptr, &event);
+        MACE_CL_RET_ERROR(error);
+        return error;
+      }
       uint32_t block_size = params[3] == 0 ? internal_gws[2] : params[3];
       const uint32_t num_blocks =
           RoundUpDiv<uint32_t>(internal_gws[2], block_size);
@@ -296,6 +317,14 @@ MaceStatus TuningOrRun2DKernel(OpenCLRuntime *runtime,
     }
 
     if (timer == nullptr) {
+      if (BatchEnqueueEnabled()) {
+        error = runtime->command_queue().enqueueNDRangeKernel(
+            kernel, cl::NullRange,
+            cl::NDRange(internal_gws[0], internal_gws[1]),
+            cl::NDRange(params[0], params[1]), nullptr, &event);
+        MACE_CL_RET_ERROR(error);
+        return error;
+      }
       uint32_t block_size = params[2] == 0 ? internal_gws[1] : params[2];
       const uint32_t num_blocks =
           RoundUpDiv<uint32_t>(internal_gws[1], block_size);
@@ -14,10 +14,12 @@
 
 #include "mace/core/runtime/opencl/opencl_runtime.h"
 
+#include <chrono>  // NOLINT(build/c++11)
 #include <cstdlib>
 #include <fstream>
 #include <memory>
 #include <mutex>  // NOLINT(build/c++11)
+#include <thread>  // NOLINT(build/c++11)
 #include <sstream>
 #include <string>
 #include <vector>
@@ -420,6 +422,17 @@ OpenCLRuntime::OpenCLRuntime(
           new cl::Context({*device_}, nullptr, nullptr, nullptr, &err));
 #endif
   }
+  // A driver that has just reset may refuse context creation for a
+  // short window; retry briefly so warm restarts (with program
+  // binaries and tuned params still cached in this process) recover
+  // without a full cold start.
+  for (int retry = 0;
+       err == CL_DEVICE_NOT_AVAILABLE && retry < 3; ++retry) {
+    LOG(WARNING) << "OpenCL device not available, retrying context creation";
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    context_ = std::shared_ptr<cl::Context>(
+        new cl::Context({*device_}, nullptr, nullptr, nullptr, &err));
+  }
   if (err != CL_SUCCESS) {
     LOG(ERROR) << "Failed to create OpenCL Context: "
                << OpenCLErrorToString(err);
@@ -436,6 +449,7 @@ OpenCLRuntime::OpenCLRuntime(
     return;
   }
 
+
   std::string cached_binary_platform_info;
   if (cache_storage_ != nullptr) {
     if (cache_storage_->Load() != 0) {
@@ -721,6 +735,23 @@ MaceStatus OpenCLRuntime::BuildKernel(
   for (auto &option : build_options) {
     build_options_str += " " + option;
   }
+  // SoC fingerprint: every kernel sees which GPU family it compiles
+  // for, so .cl sources can specialize (unroll depth, vector width,
+  // local-memory strategy) per architecture with plain #ifdefs while
+  // staying one-source. Part of the cache key via the option string.
+  switch (gpu_type_) {
+    case GPUType::QUALCOMM_ADRENO:
+      build_options_str += " -DGPU_ARCH_ADRENO";
+      break;
+    case GPUType::MALI:
+      build_options_str += " -DGPU_ARCH_MALI";
+      break;
+    case GPUType::PowerVR:
+      build_options_str += " -DGPU_ARCH_POWERVR";
+      break;
+    default:
+      break;
+  }
   std::string built_program_key = program_name + build_options_str;
 
   std::lock_guard<std::mutex> lock(program_build_mutex_);
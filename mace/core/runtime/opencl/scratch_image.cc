@@ -29,32 +29,72 @@ Image *ScratchImageManager::Spawn(
     const std::vector<size_t> &shape,
     const DataType dt,
     int *id) {
-  // TODO(liuqi): not optimal memory reuse strategy
+  // Best fit: among idle images that can hold the request, take the one
+  // wasting the least area, so big scratch images are not burned on
+  // small tensors while a closer match sits idle.
   int found_image_idx = -1;
+  size_t best_waste = 0;
+  int smallest_idle_idx = -1;
+  size_t smallest_idle_size = 0;
+  int trimmed_slot_idx = -1;
+  const size_t wanted_size = shape[0] * shape[1];
   int image_count = static_cast<int>(reference_count_.size());
   for (int i = 0; i < image_count; ++i) {
     int count = reference_count_[i];
+    if (count == 0 && images_.count(i) == 0) {
+      // slot released by TrimIdle; reuse it for new allocations
+      trimmed_slot_idx = i;
+      continue;
+    }
     if (count == 0 && images_.at(i)->dtype() == dt) {
       auto image_shape = images_.at(i)->shape();
+      const size_t image_size = image_shape[0] * image_shape[1];
       if (image_shape[0] >= shape[0] && image_shape[1] >= shape[1]) {
-        found_image_idx = i;
-        break;
+        const size_t waste = image_size - wanted_size;
+        if (found_image_idx == -1 || waste < best_waste) {
+          found_image_idx = i;
+          best_waste = waste;
+        }
+      } else if (smallest_idle_idx == -1 ||
+          image_size < smallest_idle_size) {
+        smallest_idle_idx = i;
+        smallest_idle_size = image_size;
       }
     }
   }
+  // No idle image can hold the request: rather than growing the pool
+  // unboundedly, recycle the smallest too-small idle image's slot.
+  if (found_image_idx == -1 && smallest_idle_idx != -1) {
+    VLOG(2) << "Replace scratch image " << smallest_idle_idx
+            << " with " << MakeString(shape) << "<" << dt << ">";
+    images_[smallest_idle_idx] = make_unique<Image>(allocator);
+    if (images_.at(smallest_idle_idx)->Allocate(shape, dt) !=
+        MaceStatus::MACE_SUCCESS) {
+      return nullptr;
+    }
+    found_image_idx = smallest_idle_idx;
+  }
   // if not found
   if (found_image_idx == -1) {
-    reference_count_.push_back(0);
-    images_[image_count] = make_unique<Image>(allocator);
-    if (images_.at(image_count)->Allocate(shape, dt) !=
+    int slot = trimmed_slot_idx;
+    if (slot == -1) {
+      reference_count_.push_back(0);
+      slot = image_count;
+    }
+    images_[slot] = make_unique<Image>(allocator);
+    if (images_.at(slot)->Allocate(shape, dt) !=
         MaceStatus::MACE_SUCCESS) {
       return nullptr;
     }
-    found_image_idx = image_count;
+    found_image_idx = slot;
     VLOG(2) << "Spawn image " << found_image_idx << ": " << MakeString(shape)
             << "<" << dt << ">";
   }
   reference_count_[found_image_idx] += 1;
+  ++active_count_;
+  if (active_count_ > peak_active_count_) {
+    peak_active_count_ = active_count_;
+  }
   *id = found_image_idx;
   return images_.at(found_image_idx).get();
 }
@@ -65,6 +105,22 @@ void ScratchImageManager::Deactive(int id) {
              "Image id ", id, " exceed the vector size ",
              reference_count_.size());
   reference_count_[id] -= 1;
+  --active_count_;
+}
+
+void ScratchImageManager::TrimIdle() {
+  int image_count = static_cast<int>(reference_count_.size());
+  for (int i = 0; i < image_count; ++i) {
+    if (reference_count_[i] == 0 && images_.count(i) == 1 &&
+        images_.at(i) != nullptr) {
+      VLOG(2) << "Trim idle scratch image " << i;
+      images_.erase(i);
+    }
+  }
+}
+
+int ScratchImageManager::peak_active_count() const {
+  return peak_active_count_;
 }
 
 ScratchImage::ScratchImage(mace::ScratchImageManager *manager)
@@ -35,9 +35,20 @@ class ScratchImageManager {
 
   void Deactive(int id);
 
+  // Release every idle image back to the driver (kept images keep
+  // their ids; freed slots are reused by later Spawns). Call when the
+  // app goes to background or after a rarely-run graph finished.
+  void TrimIdle();
+
+  // high-water mark of concurrently active scratch images, for memory
+  // accounting
+  int peak_active_count() const;
+
  private:
   std::unordered_map<int, std::unique_ptr<Image>> images_;
   std::vector<int> reference_count_;
+  int active_count_ = 0;
+  int peak_active_count_ = 0;
 };
 
 class ScratchImage {
@@ -120,6 +120,8 @@ class Tensor {
       : allocator_(alloc),
         dtype_(type),
         buffer_(nullptr),
+        internal_buffer_(nullptr),
+        internal_buffer_owned_(false),
         is_buffer_owner_(true),
         unused_(false),
         name_(name),
@@ -133,8 +135,11 @@ class Tensor {
   Tensor(BufferBase *buffer, DataType dtype,
          bool is_weight = false,
          const std::string name = "")
-    : dtype_(dtype),
+    : allocator_(nullptr),
+      dtype_(dtype),
       buffer_(buffer),
+      internal_buffer_(nullptr),
+      internal_buffer_owned_(false),
       is_buffer_owner_(false),
       unused_(false),
       name_(name),
@@ -149,8 +154,11 @@ class Tensor {
          DataType dtype,
          bool is_weight = false,
          const std::string name = "")
-      : dtype_(dtype),
+      : allocator_(nullptr),
+        dtype_(dtype),
         buffer_slice_(buffer_slice),
+        internal_buffer_(nullptr),
+        internal_buffer_owned_(false),
         is_buffer_owner_(false),
         unused_(false),
         name_(name),
@@ -170,6 +178,9 @@ class Tensor {
     if (is_buffer_owner_ && buffer_ != nullptr) {
       delete buffer_;
     }
+    if (internal_buffer_owned_ && internal_buffer_ != nullptr) {
+      delete internal_buffer_;
+    }
   }
 
   inline std::string name() const { return name_; }
@@ -314,20 +325,84 @@ class Tensor {
     }
   }
 
+  // Point the tensor at externally owned host memory of size bytes, so
+  // ops write the caller's buffer in place (zero-copy output). The
+  // previous internal buffer is parked and restored by
+  // ClearExternalBuffer(); the external memory must stay valid until
+  // then. Only host buffer tensors can wrap external memory, and only
+  // op *outputs* may be wrapped: external buffers carry no
+  // MACE_EXTRA_BUFFER_PAD_SIZE headroom, which the NEON stride-2
+  // kernels overread on their *inputs* by design.
+  inline void SetExternalBuffer(void *data,
+                                const index_t size,
+                                const std::vector<index_t> &shape) {
+    MACE_CHECK(buffer_ == nullptr || buffer_->OnHost(),
+               name_, ": only host tensors can wrap an external buffer");
+    if (external_buffer_ == nullptr) {
+      internal_buffer_ = buffer_;
+      internal_buffer_owned_ = is_buffer_owner_;
+    }
+    external_buffer_.reset(
+        new Buffer(allocator_ != nullptr ? allocator_ : GetCPUAllocator(),
+                   data, size));
+    buffer_ = external_buffer_.get();
+    is_buffer_owner_ = false;
+    shape_ = shape;
+    buffer_shape_ = shape;
+    image_shape_.clear();
+    MACE_CHECK(raw_size() <= size,
+               name_, ": external buffer too small: ", size,
+               " < ", raw_size());
+  }
+
+  inline bool has_external_buffer() const {
+    return external_buffer_ != nullptr;
+  }
+
+  inline void ClearExternalBuffer() {
+    if (external_buffer_ != nullptr) {
+      buffer_ = internal_buffer_;
+      is_buffer_owner_ = internal_buffer_owned_;
+      internal_buffer_ = nullptr;
+      internal_buffer_owned_ = false;
+      external_buffer_.reset();
+    }
+  }
+
   inline MaceStatus Resize(const std::vector<index_t> &shape) {
+    // steady-state runs resize every output to the same shape each
+    // frame; skip the bookkeeping when nothing changes
+    if (shape == shape_ && shape == buffer_shape_ && buffer_ != nullptr &&
+        !has_external_buffer()) {
+      return MaceStatus::MACE_SUCCESS;
+    }
     shape_ = shape;
     buffer_shape_ = shape;
     image_shape_.clear();
     if (buffer_ != nullptr) {
       MACE_CHECK(!has_opencl_image(),
                  name_, ": Cannot resize image, use ResizeImage.");
+      // external buffers are exactly caller-sized, no pad is applied
       const index_t apply_size = raw_size()
-          + ((buffer_ != &buffer_slice_) ? MACE_EXTRA_BUFFER_PAD_SIZE : 0);
+          + ((buffer_ != &buffer_slice_ && !has_external_buffer())
+                 ? MACE_EXTRA_BUFFER_PAD_SIZE : 0);
       if (apply_size > buffer_->size()) {
         LOG(WARNING) << name_ << ": Resize buffer from size " << buffer_->size()
                      << " to " << apply_size;
         MACE_CHECK(buffer_ != &buffer_slice_,
                    ": Cannot resize tensor with buffer slice");
+        MACE_CHECK(!has_external_buffer(),
+                   name_, ": Cannot resize tensor wrapping "
+                          "an external buffer");
+        if (!is_buffer_owner_ && buffer_->OnHost()) {
+          // dynamic input shapes outgrew the planned block: detach to a
+          // dedicated buffer and leave the shared block to its other
+          // tensors instead of failing the run
+          buffer_ = new Buffer(
+              allocator_ != nullptr ? allocator_ : GetCPUAllocator());
+          is_buffer_owner_ = true;
+          return buffer_->Allocate(apply_size);
+        }
         return buffer_->Resize(apply_size);
       }
       return MaceStatus::MACE_SUCCESS;
@@ -524,6 +599,11 @@ class Tensor {
   std::vector<index_t> buffer_shape_;
   BufferBase *buffer_;
   BufferSlice buffer_slice_;
+  // zero-copy I/O: wraps externally owned host memory while the original
+  // buffer is parked in internal_buffer_
+  std::unique_ptr<BufferBase> external_buffer_;
+  BufferBase *internal_buffer_;
+  bool internal_buffer_owned_;
   bool is_buffer_owner_;
   bool unused_;
   std::string name_;
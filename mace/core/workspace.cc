@@ -14,12 +14,19 @@
 
 #include "mace/core/workspace.h"
 
+#include <algorithm>
+#include <cstring>
+#include <mutex>  // NOLINT(build/c++11)
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "mace/core/arg_helper.h"
 #include "mace/core/memory_optimizer.h"
 #include "mace/core/quantize.h"
+#include "mace/utils/conf_util.h"
+#include "mace/utils/memory.h"
 
 #ifdef MACE_ENABLE_OPENCL
 #include "mace/core/runtime/opencl/opencl_runtime.h"
@@ -28,6 +35,15 @@
 namespace mace {
 
 namespace {
+bool HasCodebookTensor(const NetDef &net_def) {
+  for (auto &tensor : net_def.tensors()) {
+    if (tensor.codebook_size() > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool HasQuantizedTensor(const NetDef &net_def) {
   for (auto &tensor : net_def.tensors()) {
     if (tensor.quantized()) {
@@ -57,14 +73,109 @@ void DequantizeTensor(Device *device,
   auto dequantized_data = output_tensor->mutable_data<T>();
   QuantizeUtil<T, uint8_t>
       quantize_util(&device->cpu_runtime()->thread_pool());
-  quantize_util.Dequantize(quantized_data,
-                           output_tensor->size(),
-                           const_tensor.scale(),
-                           const_tensor.zero_point(),
-                           dequantized_data);
+  if (const_tensor.channel_scales_size() > 0) {
+    // per-output-channel quantized weights (one scale per dims[0] slice)
+    const index_t channels = const_tensor.dims(0);
+    MACE_CHECK(const_tensor.channel_scales_size() == channels &&
+                   const_tensor.channel_zero_points_size() == channels,
+               "channel quant params must match dims[0] of ",
+               const_tensor.name());
+    quantize_util.DequantizePerChannel(
+        quantized_data,
+        channels,
+        output_tensor->size() / channels,
+        const_tensor.channel_scales().data(),
+        const_tensor.channel_zero_points().data(),
+        dequantized_data);
+  } else {
+    quantize_util.Dequantize(quantized_data,
+                             output_tensor->size(),
+                             const_tensor.scale(),
+                             const_tensor.zero_point(),
+                             dequantized_data);
+  }
 }
 
 
+template<typename T>
+void DecodeCodebookTensor(Device *device,
+                          const unsigned char *model_data,
+                          const ConstTensor &const_tensor,
+                          Tensor *output_tensor) {
+  Tensor::MappingGuard guard(output_tensor);
+  auto *indices = reinterpret_cast<const uint8_t *>(
+      model_data + const_tensor.offset());
+  const float *codebook = const_tensor.codebook().data();
+  T *decoded = output_tensor->mutable_data<T>();
+  device->cpu_runtime()->thread_pool().Compute1D(
+      [=](index_t start, index_t end, index_t step) {
+        for (index_t i = start; i < end; i += step) {
+          decoded[i] = codebook[indices[i]];
+        }
+      }, 0, output_tensor->size(), 1);
+}
+
+// MACE_SHARED_ACTIVATION_POOL: process-wide pool of CPU activation
+// chunks for multi-engine deployments whose engines never run
+// concurrently (detector/landmark/recognizer cascades). Each engine's
+// preallocated blocks become non-owning views over pooled chunks;
+// chunks are returned when the workspace dies and reused best-fit by
+// the next engine, so the resident high-water mark is the union
+// instead of the sum. Engines that do run concurrently must not
+// enable this.
+class SharedCpuBufferPool {
+ public:
+  static SharedCpuBufferPool *Get() {
+    static SharedCpuBufferPool pool;
+    return &pool;
+  }
+
+  std::unique_ptr<BufferBase> Acquire(const Workspace *tag, index_t nbytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // a chunk may back blocks of several engines (their runs are
+    // serialized by contract), but never two blocks of one engine,
+    // which are live at the same time within a run
+    int best = -1;
+    for (size_t i = 0; i < chunks_.size(); ++i) {
+      if (chunks_[i].users.count(tag) == 0 && chunks_[i].size >= nbytes &&
+          (best < 0 || chunks_[i].size < chunks_[best].size)) {
+        best = static_cast<int>(i);
+      }
+    }
+    if (best < 0) {
+      Chunk chunk;
+      chunk.storage.reset(new Buffer(GetCPUAllocator()));
+      if (chunk.storage->Allocate(nbytes) != MaceStatus::MACE_SUCCESS) {
+        return nullptr;
+      }
+      chunk.size = nbytes;
+      chunks_.push_back(std::move(chunk));
+      best = static_cast<int>(chunks_.size()) - 1;
+    }
+    chunks_[best].users.insert(tag);
+    return make_unique<Buffer>(GetCPUAllocator(),
+                               chunks_[best].storage->raw_mutable_data(),
+                               nbytes);
+  }
+
+  void ReleaseAll(const Workspace *tag) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &chunk : chunks_) {
+      chunk.users.erase(tag);
+    }
+  }
+
+ private:
+  struct Chunk {
+    std::unique_ptr<Buffer> storage;
+    index_t size = 0;
+    std::unordered_set<const Workspace *> users;
+  };
+
+  std::mutex mutex_;
+  std::vector<Chunk> chunks_;
+};
+
 index_t GetModelValidSize(const NetDef &net_def) {
   index_t valid_data_size = 0;
   for (auto &const_tensor : net_def.tensors()) {
@@ -79,7 +190,16 @@ index_t GetModelValidSize(const NetDef &net_def) {
 }  // namespace
 
 Workspace::Workspace(const OpDelegatorRegistry *registry) :
-    op_delegator_registry_(registry) {}
+    op_delegator_registry_(registry),
+    use_shared_activation_pool_(
+        EnvConfEnabled("MACE_SHARED_ACTIVATION_POOL")) {}
+
+Workspace::~Workspace() {
+  if (use_shared_activation_pool_) {
+    // blocks are views over pooled chunks; hand the chunks back
+    SharedCpuBufferPool::Get()->ReleaseAll(this);
+  }
+}
 
 Tensor *Workspace::CreateTensor(const std::string &name,
                                 Allocator *alloc,
@@ -117,6 +237,24 @@ std::vector<std::string> Workspace::Tensors() const {
   return names;
 }
 
+// Weight-delivery pipeline notes, kept together because they share
+// the same constraint -- everything below consumes one flat
+// model_data region with proto-recorded offsets:
+//  * zstd streaming decompression (user request): the per-tensor
+//    loops here could consume a streaming frame, but the third-party
+//    manifest carries no zstd; when it does, decompress per const
+//    tensor into the diffused path and the copy disappears into the
+//    existing per-tensor pass.
+//  * tensor-granular delta updates: offsets+data_size in ConstTensor
+//    already give the patch boundaries; an on-device patcher is file
+//    tooling (old file + delta -> new file) and needs no runtime
+//    change beyond what exists.
+//  * multi-model bundles with shared weights: two NetDefs whose const
+//    tensors point into one weight pool already work per engine (each
+//    maps the same file, and the CPU slice path keeps it page-shared
+//    via mmap -- the kernel dedupes the clean pages). True cross-
+//    engine Tensor sharing needs a shared workspace, same blocker as
+//    cross-engine image sharing.
 MaceStatus Workspace::LoadModelTensor(const NetDef &net_def, Device *device,
                                       const unsigned char *model_data,
                                       const index_t model_data_size) {
@@ -133,7 +271,8 @@ MaceStatus Workspace::LoadModelTensor(const NetDef &net_def, Device *device,
     bool is_quantize_model = IsQuantizedModel(net_def);
     diffused_buffer_ =
         (device_type == DeviceType::CPU && HasHalfTensor(net_def)) ||
-            (!is_quantize_model && HasQuantizedTensor(net_def));
+            (!is_quantize_model && HasQuantizedTensor(net_def)) ||
+            HasCodebookTensor(net_def);
 #ifdef MACE_ENABLE_OPENCL
     diffused_buffer_ = diffused_buffer_ || (device_type == DeviceType::GPU &&
         device->gpu_runtime()->opencl_runtime()->GetDeviceMaxMemAllocSize() <=
@@ -155,6 +294,12 @@ MaceStatus Workspace::LoadModelTensor(const NetDef &net_def, Device *device,
         if (device_type == DeviceType::CPU &&
             const_tensor.data_type() == DataType::DT_HALF) {
           dst_data_type = DataType::DT_FLOAT;
+        } else if (const_tensor.codebook_size() > 0) {
+          if (device_type == GPU && net_def.data_type() != DataType::DT_FLOAT) {
+            dst_data_type = DataType::DT_HALF;
+          } else {
+            dst_data_type = DataType::DT_FLOAT;
+          }
         } else if (!is_quantize_model && const_tensor.quantized()) {
           if (device_type == GPU && net_def.data_type() != DataType::DT_FLOAT) {
             dst_data_type = DataType::DT_HALF;
@@ -179,12 +324,29 @@ MaceStatus Workspace::LoadModelTensor(const NetDef &net_def, Device *device,
 
         if (device_type == DeviceType::CPU &&
             const_tensor.data_type() == DataType::DT_HALF) {
-          // uncompress the weights of fp16
+          // uncompress the weights of fp16, spread across the compute
+          // threads: this dominates Init for fp16-stored models
           auto org_data = reinterpret_cast<const half *>(
               model_data + const_tensor.offset());
           float *dst_data = tensor->mutable_data<float>();
-          for (int i = 0; i < const_tensor.data_size(); ++i) {
-            dst_data[i] = half_float::half_cast<float>(org_data[i]);
+          device->cpu_runtime()->thread_pool().Compute1D(
+              [=](index_t start, index_t end, index_t step) {
+                for (index_t i = start; i < end; i += step) {
+                  dst_data[i] = half_float::half_cast<float>(org_data[i]);
+                }
+              }, 0, const_tensor.data_size(), 1);
+        } else if (const_tensor.codebook_size() > 0) {
+          // expand clustered weights: stored bytes are codebook indices
+          if (dst_data_type != DT_FLOAT) {
+            DecodeCodebookTensor<half>(device,
+                                       model_data,
+                                       const_tensor,
+                                       tensor.get());
+          } else {
+            DecodeCodebookTensor<float>(device,
+                                        model_data,
+                                        const_tensor,
+                                        tensor.get());
           }
         } else if (!is_quantize_model && const_tensor.quantized()) {
           // uncompress the weights of uint8
@@ -203,6 +365,10 @@ MaceStatus Workspace::LoadModelTensor(const NetDef &net_def, Device *device,
           tensor->CopyBytes(model_data + const_tensor.offset(),
                             const_tensor.data_size() *
                                 GetEnumTypeSize(const_tensor.data_type()));
+          // quantized tensors loaded verbatim keep their parameters,
+          // as the BufferSlice path below does
+          tensor->SetScale(const_tensor.scale());
+          tensor->SetZeroPoint(const_tensor.zero_point());
         }
 
         tensor_map_[const_tensor.name()] = std::move(tensor);
@@ -218,8 +384,20 @@ MaceStatus Workspace::LoadModelTensor(const NetDef &net_def, Device *device,
             new Buffer(device->allocator()));
         MACE_RETURN_IF_ERROR(tensor_buffer_->Allocate(valid_data_size));
         tensor_buffer_->Map(nullptr);
-        tensor_buffer_->Copy(const_cast<unsigned char *>(model_data),
-                             0, valid_data_size);
+        // chunked parallel upload: this single copy dominates Init for
+        // large GPU models
+        uint8_t *dst =
+            reinterpret_cast<uint8_t *>(tensor_buffer_->raw_mutable_data());
+        constexpr index_t kCopyChunkSize = 1 << 20;
+        device->cpu_runtime()->thread_pool().Compute1D(
+            [=](index_t start, index_t end, index_t step) {
+              for (index_t i = start; i < end; i += step) {
+                const index_t offset = i * kCopyChunkSize;
+                const index_t bytes =
+                    std::min(kCopyChunkSize, valid_data_size - offset);
+                memcpy(dst + offset, model_data + offset, bytes);
+              }
+            }, 0, (valid_data_size + kCopyChunkSize - 1) / kCopyChunkSize, 1);
         tensor_buffer_->UnMap();
       }
       for (auto &const_tensor : net_def.tensors()) {
@@ -258,15 +436,46 @@ MaceStatus Workspace::PreallocateOutputTensor(
     const mace::MemoryOptimizer *mem_optimizer,
     Device *device) {
   auto &mem_blocks = mem_optimizer->mem_blocks();
+  // All CPU blocks live in one contiguous arena; each block becomes an
+  // offset view, so the whole activation footprint is one allocation
+  // (one mmap/hugepage candidate, one line in memory profiles).
+  index_t cpu_arena_size = 0;
+  std::unordered_map<int, index_t> cpu_block_offsets;
+  if (!use_shared_activation_pool_) {
+    int color = 0;
+    for (auto &mem_block : mem_blocks) {
+      if (mem_block.mem_type() == MemoryType::CPU_BUFFER) {
+        cpu_block_offsets[mem_block.mem_id()] = cpu_arena_size;
+        // stagger block bases by a cache line each so the input/weight/
+        // output streams of a conv do not alias the same L1/L2 sets
+        // (power-of-two tensor sizes otherwise line up exactly)
+        cpu_arena_size += static_cast<index_t>(PadAlignSize(
+            mem_block.x() + MACE_EXTRA_BUFFER_PAD_SIZE)) +
+            (color++ % 8) * static_cast<index_t>(kMaceAlignment);
+      }
+    }
+    if (cpu_arena_size > 0) {
+      cpu_block_arena_.reset(new Buffer(GetCPUAllocator()));
+      MACE_RETURN_IF_ERROR(cpu_block_arena_->Allocate(cpu_arena_size));
+    }
+  }
   for (auto &mem_block : mem_blocks) {
     VLOG(3) << "Preallocate memory block. id: " << mem_block.mem_id()
             << ", memory type: " << mem_block.mem_type()
             << ", size: " << mem_block.x() << "x" << mem_block.y();
     if (mem_block.mem_type() == MemoryType::CPU_BUFFER) {
-      std::unique_ptr<BufferBase> tensor_buf(
-          new Buffer(GetCPUAllocator()));
-      MACE_RETURN_IF_ERROR(tensor_buf->Allocate(
-          mem_block.x() + MACE_EXTRA_BUFFER_PAD_SIZE));
+      std::unique_ptr<BufferBase> tensor_buf;
+      if (use_shared_activation_pool_) {
+        tensor_buf = SharedCpuBufferPool::Get()->Acquire(
+            this, mem_block.x() + MACE_EXTRA_BUFFER_PAD_SIZE);
+        MACE_CHECK_NOTNULL(tensor_buf.get());
+      } else {
+        tensor_buf = make_unique<Buffer>(
+            GetCPUAllocator(),
+            reinterpret_cast<uint8_t *>(cpu_block_arena_->raw_mutable_data())
+                + cpu_block_offsets.at(mem_block.mem_id()),
+            mem_block.x() + MACE_EXTRA_BUFFER_PAD_SIZE);
+      }
       preallocated_allocator_.SetBuffer(mem_block.mem_id(),
                                         std::move(tensor_buf));
     } else if (mem_block.mem_type() == MemoryType::GPU_IMAGE) {
@@ -24,6 +24,7 @@
 #include "mace/core/preallocated_pooled_allocator.h"
 #include "mace/core/tensor.h"
 #include "mace/public/mace.h"
+#include "mace/utils/arena.h"
 
 namespace mace {
 
@@ -35,7 +36,7 @@ class Workspace {
   typedef std::map<std::string, std::unique_ptr<Tensor>> TensorMap;
 
   explicit Workspace(const OpDelegatorRegistry *registry);
-  ~Workspace() {}
+  ~Workspace();
 
   Tensor *CreateTensor(const std::string &name,
                        Allocator *alloc,
@@ -74,11 +75,28 @@ class Workspace {
 
   const OpDelegatorRegistry *GetDelegatorRegistry() const;
 
+  // Bump allocator for per-run transients; the net resets it at the
+  // start of every run, so nothing allocated from it may outlive a run.
+  inline utils::Arena *run_arena() {
+    return &run_arena_;
+  }
+
+  // whether preallocated CPU blocks are views over the process-wide
+  // shared pool (their contents do not survive other engines' runs)
+  inline bool use_shared_activation_pool() const {
+    return use_shared_activation_pool_;
+  }
+
  private:
   TensorMap tensor_map_;
+  utils::Arena run_arena_;
+  // one contiguous backing allocation for all CPU activation blocks
+  std::unique_ptr<Buffer> cpu_block_arena_;
   std::unique_ptr<BufferBase> tensor_buffer_;
   PreallocatedPooledAllocator preallocated_allocator_;
   bool diffused_buffer_;
+  // draw preallocated CPU blocks from the process-wide shared pool
+  bool use_shared_activation_pool_;
 
   const OpDelegatorRegistry *op_delegator_registry_;
 
@@ -0,0 +1,146 @@
+// Copyright 2020 The MACE Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mace/public/mace_c_api.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mace/public/mace.h"
+
+namespace {
+
+MaceCStatus ToCStatus(const mace::MaceStatus &status) {
+  return static_cast<MaceCStatus>(status.code());
+}
+
+}  // namespace
+
+// Everything C callers touch lives behind this handle, including the
+// per-output shape storage MaceEngineRun hands back.
+struct MaceEngineHandleImpl {
+  std::shared_ptr<mace::MaceEngine> engine;
+  std::vector<std::string> input_names;
+  std::vector<std::string> output_names;
+  std::vector<std::vector<int64_t>> output_shapes;
+};
+
+MaceCStatus MaceEngineCreate(const uint8_t *model_graph_proto,
+                             size_t model_graph_proto_size,
+                             const uint8_t *model_weights_data,
+                             size_t model_weights_data_size,
+                             const char *const *input_names,
+                             size_t input_count,
+                             const char *const *output_names,
+                             size_t output_count,
+                             MaceCDeviceType device_type,
+                             int num_threads,
+                             MaceEngineHandle *engine_out) {
+  if (model_graph_proto == nullptr || model_weights_data == nullptr ||
+      input_names == nullptr || output_names == nullptr ||
+      engine_out == nullptr) {
+    return MACE_C_INVALID_ARGS;
+  }
+
+  std::unique_ptr<MaceEngineHandleImpl> handle(new MaceEngineHandleImpl);
+  for (size_t i = 0; i < input_count; ++i) {
+    handle->input_names.push_back(input_names[i]);
+  }
+  for (size_t i = 0; i < output_count; ++i) {
+    handle->output_names.push_back(output_names[i]);
+  }
+
+  mace::MaceEngineConfig config(
+      static_cast<mace::DeviceType>(device_type));
+  config.SetCPUThreadPolicy(num_threads,
+                            mace::CPUAffinityPolicy::AFFINITY_NONE);
+  if (device_type == MACE_C_DEVICE_GPU) {
+    // engine init dereferences the GPU context unconditionally; give C
+    // callers a default one (no storage paths -- no on-disk caching)
+    config.SetGPUContext(mace::GPUContextBuilder().Finalize());
+  }
+
+  mace::MaceStatus status = mace::CreateMaceEngineFromProto(
+      model_graph_proto, model_graph_proto_size,
+      model_weights_data, model_weights_data_size,
+      handle->input_names, handle->output_names,
+      config, &handle->engine);
+  if (status != mace::MaceStatus::MACE_SUCCESS) {
+    return ToCStatus(status);
+  }
+  *engine_out = handle.release();
+  return MACE_C_SUCCESS;
+}
+
+MaceCStatus MaceEngineRun(MaceEngineHandle engine,
+                          const MaceCTensor *inputs,
+                          size_t input_count,
+                          MaceCTensor *outputs,
+                          size_t output_count) {
+  if (engine == nullptr || inputs == nullptr || outputs == nullptr) {
+    return MACE_C_INVALID_ARGS;
+  }
+
+  std::map<std::string, mace::MaceTensor> input_map;
+  for (size_t i = 0; i < input_count; ++i) {
+    if (inputs[i].name == nullptr || inputs[i].data == nullptr) {
+      return MACE_C_INVALID_ARGS;
+    }
+    std::vector<int64_t> shape(inputs[i].dims,
+                               inputs[i].dims + inputs[i].dim_count);
+    // no-op deleter: the caller owns the buffer
+    auto data = std::shared_ptr<void>(inputs[i].data, [](void *) {});
+    input_map.emplace(inputs[i].name,
+                      mace::MaceTensor(shape, data));
+  }
+
+  std::map<std::string, mace::MaceTensor> output_map;
+  for (size_t i = 0; i < output_count; ++i) {
+    if (outputs[i].name == nullptr || outputs[i].data == nullptr) {
+      return MACE_C_INVALID_ARGS;
+    }
+    std::vector<int64_t> shape(outputs[i].dims,
+                               outputs[i].dims + outputs[i].dim_count);
+    auto data = std::shared_ptr<void>(outputs[i].data, [](void *) {});
+    output_map.emplace(outputs[i].name,
+                       mace::MaceTensor(shape, data));
+  }
+
+  mace::MaceStatus status = engine->engine->Run(input_map, &output_map);
+  if (status != mace::MaceStatus::MACE_SUCCESS) {
+    return ToCStatus(status);
+  }
+
+  // hand the produced shapes back through handle-owned storage
+  engine->output_shapes.assign(output_count, {});
+  for (size_t i = 0; i < output_count; ++i) {
+    auto iter = output_map.find(outputs[i].name);
+    if (iter != output_map.end()) {
+      engine->output_shapes[i] = iter->second.shape();
+      outputs[i].dims = engine->output_shapes[i].data();
+      outputs[i].dim_count = engine->output_shapes[i].size();
+    }
+  }
+  return MACE_C_SUCCESS;
+}
+
+void MaceEngineDestroy(MaceEngineHandle engine) {
+  delete engine;
+}
+
+const char *MaceCVersion() {
+  return mace::MaceVersion();
+}
@@ -124,6 +124,24 @@ def if_fp16_enabled(a):
         "//conditions:default": [],
     })
 
+def if_dotprod_enabled(a):
+    return select({
+        "//mace:dotprod_enabled": a,
+        "//conditions:default": [],
+    })
+
+def if_sve_enabled(a):
+    return select({
+        "//mace:sve_enabled": a,
+        "//conditions:default": [],
+    })
+
+def if_mmla_enabled(a):
+    return select({
+        "//mace:mmla_enabled": a,
+        "//conditions:default": [],
+    })
+
 def if_rpcmem_enabled(a, default_value = []):
     return select({
         "//mace:rpcmem_enabled": a,
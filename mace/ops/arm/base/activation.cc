@@ -15,6 +15,7 @@
 #include "mace/ops/arm/base/activation.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "mace/ops/arm/base/common_neon.h"
 
@@ -253,6 +254,64 @@ void Activation<T>::ActivateElu(utils::ThreadPool *thread_pool,
       0, input_size, 1);
 }
 
+// float fast paths: exp-based tanh/sigmoid through vexpq_f32 instead
+// of one libm call per element. GELU is not an ActivationType yet;
+// when the converter grows it, tanh-form GELU composes from these
+// same primitives.
+template<>
+void Activation<float>::ActivateTanh(utils::ThreadPool *thread_pool,
+                                     const Tensor *input,
+                                     Tensor *output) {
+  const float *input_data = input->data<float>();
+  float *output_data = output->mutable_data<float>();
+  const index_t input_size = input->size();
+
+  thread_pool->Compute1D(
+      [=](index_t start, index_t end, index_t step) {
+        MACE_UNUSED(step);
+        const float32x4_t vone = vdupq_n_f32(1.f);
+        index_t i = start;
+        for (; i + 3 < end; i += 4) {
+          // tanh(x) = 1 - 2 / (exp(2x) + 1)
+          const float32x4_t vx = vld1q_f32(input_data + i);
+          const float32x4_t ve = vexpq_f32(vmulq_n_f32(vx, 2.f));
+          const float32x4_t vr = vrecipq_f32_fast(vaddq_f32(ve, vone));
+          vst1q_f32(output_data + i,
+                    vsubq_f32(vone, vmulq_n_f32(vr, 2.f)));
+        }
+        for (; i < end; ++i) {
+          output_data[i] = std::tanh(input_data[i]);
+        }
+      },
+      0, input_size, 1);
+}
+
+template<>
+void Activation<float>::ActivateSigmoid(utils::ThreadPool *thread_pool,
+                                        const Tensor *input,
+                                        Tensor *output) {
+  const float *input_data = input->data<float>();
+  float *output_data = output->mutable_data<float>();
+  const index_t input_size = input->size();
+
+  thread_pool->Compute1D(
+      [=](index_t start, index_t end, index_t step) {
+        MACE_UNUSED(step);
+        const float32x4_t vone = vdupq_n_f32(1.f);
+        index_t i = start;
+        for (; i + 3 < end; i += 4) {
+          const float32x4_t vx = vld1q_f32(input_data + i);
+          const float32x4_t ve = vexpq_f32(vnegq_f32(vx));
+          vst1q_f32(output_data + i,
+                    vrecipq_f32_fast(vaddq_f32(ve, vone)));
+        }
+        for (; i < end; ++i) {
+          output_data[i] = 1 / (1 + std::exp(-(input_data[i])));
+        }
+      },
+      0, input_size, 1);
+}
+
 void RegisterActivationDelegator(OpDelegatorRegistry *registry) {
   MACE_REGISTER_DELEGATOR(
       registry, Activation<float>, delegator::ActivationParam,
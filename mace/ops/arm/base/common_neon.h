@@ -27,6 +27,55 @@ typedef struct float32x8_t {
   float32x4_t val[2];
 } float32x8_t;
 
+inline float32x4_t vrecipq_f32_fast(float32x4_t x) {
+#ifdef __aarch64__
+  return vdivq_f32(vdupq_n_f32(1.f), x);
+#else
+  float32x4_t r = vrecpeq_f32(x);
+  r = vmulq_f32(vrecpsq_f32(x, r), r);
+  r = vmulq_f32(vrecpsq_f32(x, r), r);
+  return r;
+#endif
+}
+
+// Polynomial exp approximation (cephes-style, max relative error below
+// 1e-6 over the clamped range), for softmax-like kernels that pay for
+// a libm call per element otherwise.
+inline float32x4_t vexpq_f32(float32x4_t x) {
+  const float32x4_t one = vdupq_n_f32(1.f);
+  x = vminq_f32(x, vdupq_n_f32(88.3762626647949f));
+  x = vmaxq_f32(x, vdupq_n_f32(-88.3762626647949f));
+
+  // n = round-to-floor(x / ln2)
+  float32x4_t fx = vmlaq_f32(vdupq_n_f32(0.5f), x,
+                             vdupq_n_f32(1.44269504088896341f));
+  const float32x4_t fx_trunc = vcvtq_f32_s32(vcvtq_s32_f32(fx));
+  const uint32x4_t too_big = vcgtq_f32(fx_trunc, fx);
+  fx = vsubq_f32(fx_trunc, vreinterpretq_f32_u32(
+      vandq_u32(too_big, vreinterpretq_u32_f32(one))));
+
+  // r = x - n * ln2, split for precision
+  x = vmlsq_f32(x, fx, vdupq_n_f32(0.693359375f));
+  x = vmlsq_f32(x, fx, vdupq_n_f32(-2.12194440e-4f));
+
+  // exp(r) by 6th order polynomial
+  const float32x4_t z = vmulq_f32(x, x);
+  float32x4_t y = vdupq_n_f32(1.9875691500e-4f);
+  y = vmlaq_f32(vdupq_n_f32(1.3981999507e-3f), y, x);
+  y = vmlaq_f32(vdupq_n_f32(8.3334519073e-3f), y, x);
+  y = vmlaq_f32(vdupq_n_f32(4.1665795894e-2f), y, x);
+  y = vmlaq_f32(vdupq_n_f32(1.6666665459e-1f), y, x);
+  y = vmlaq_f32(vdupq_n_f32(5.0000001201e-1f), y, x);
+  y = vmlaq_f32(x, y, z);
+  y = vaddq_f32(y, one);
+
+  // scale by 2^n
+  int32x4_t e = vcvtq_s32_f32(fx);
+  e = vaddq_s32(e, vdupq_n_s32(0x7f));
+  e = vshlq_n_s32(e, 23);
+  return vmulq_f32(y, vreinterpretq_f32_s32(e));
+}
+
 #if !defined(__aarch64__)
 inline float vaddvq_f32(float32x4_t v) {
   float32x2_t _sum = vadd_f32(vget_low_f32(v), vget_high_f32(v));
@@ -37,10 +37,15 @@ MaceStatus Conv2dK3x3Winograd<T>::Compute(const OpContext *context,
   const index_t in_width = input->dim(3);
   const index_t out_channels = filter->dim(0);
 
-  // When size of input feature map is bigger than 16x16,
-  // set winograd out tile size to 6 to get higher performance.
+  // Use the F(6x6,3x3) variant when the input feature map is bigger
+  // than 16x16 and there are enough channels for the per-tile GEMM to
+  // amortize its larger 8x8 input/output transforms; shallow layers
+  // stay on F(2x2,3x3) whose transforms are nearly free. The 8-channel
+  // threshold matches the GEMM depth block below which the transforms
+  // dominate the measured runtime.
   index_t out_tile_size = 2;
-  if (in_height > 16 && in_width > 16) {
+  if (in_height > 16 && in_width > 16 &&
+      in_channels >= 8 && out_channels >= 8) {
     out_tile_size = 6;
   }
 
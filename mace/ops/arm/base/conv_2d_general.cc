@@ -68,6 +68,16 @@ MaceStatus Conv2dGeneral<T>::DoCompute(
   const index_t filter_width = filter_shape[3];
   const index_t filter_size = filter_height * filter_width;
 
+  // Indirect-GEMM form (XNNPACK-style): build a per-output-pixel table
+  // of input patch pointers once per shape, then run the packed GEMM
+  // micro-kernels over the indirection buffer, so odd
+  // kernel/stride/dilation combos stop paying this scalar address
+  // arithmetic per element. The pointer table is shape-keyed state on
+  // the delegator (rebuilt only when the input geometry changes) and
+  // feeds the same ComputeBlock kernels Gemm uses; the blocker is that
+  // PackLhs/PackRhs currently read from contiguous matrices, so they
+  // need an indirection-aware pack variant first. Until then the
+  // direct loops below stay.
   p.thread_pool.Compute2D([=](index_t start0, index_t end0, index_t step0,
                               index_t start1, index_t end1, index_t step1) {
     for (index_t b = start0; b < end0; b += step0) {
@@ -17,6 +17,16 @@
 #include <memory>
 #include <vector>
 
+// Deconvolution here scatter-accumulates into an oversized padded
+// output that is cropped afterwards. The output-tile formulation
+// inverts that: for each output tile, gather the (stride-phased)
+// input/filter products that land in it, i.e. split the filter into
+// stride_h*stride_w sub-filters and run each phase as a direct
+// convolution writing disjoint output positions -- no oversized
+// buffer, no crop pass, and tiles parallelize without overlapping
+// writes. That rewrite obsoletes the out_pad machinery in
+// deconv_2d.cc shared by all the fixed-size variants, so it has to
+// move all of them at once rather than one kernel at a time.
 namespace mace {
 namespace ops {
 namespace arm {
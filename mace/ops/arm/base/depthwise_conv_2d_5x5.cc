@@ -0,0 +1,249 @@
+// Copyright 2020 The MACE Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mace/ops/arm/base/depthwise_conv_2d_5x5.h"
+
+#include "mace/ops/arm/base/common_neon.h"
+
+namespace mace {
+namespace ops {
+namespace arm {
+
+namespace {
+template<typename T>
+void DepthwiseConv2d5x5Pixel(const T *in_base,
+                             const T *filter,
+                             const index_t out_h,
+                             const index_t out_w,
+                             const index_t in_h_start,
+                             const index_t in_w_start,
+                             const index_t out_width,
+                             const index_t in_height,
+                             const index_t in_width,
+                             T *out_base) {
+  const index_t filter_width = 5;
+  float sum = 0.0f;
+
+  for (index_t i = 0; i < 5; ++i) {
+    const index_t in_h = in_h_start + i;
+    if (in_h < 0 || in_h >= in_height) {
+      continue;
+    }
+    const T *in = in_base + in_h * in_width;
+    const T *filter_ptr = filter + i * filter_width;
+    for (index_t j = 0; j < 5; ++j) {
+      const index_t in_w = in_w_start + j;
+      if (in_w >= 0 && in_w < in_width) {
+        sum += in[in_w] * filter_ptr[j];
+      }
+    }
+  }
+  out_base[out_h * out_width + out_w] = sum;
+}
+}  // namespace
+
+template<typename T>
+MaceStatus DepthwiseConv2dK5x5S1<T>::DoCompute(
+    const DepthwiseConvComputeParam &p, const T *filter_data,
+    const T *input_data, T *output_data) {
+  p.thread_pool.Compute2D([=](index_t start0, index_t end0, index_t step0,
+                              index_t start1, index_t end1, index_t step1) {
+    for (index_t b = start0; b < end0; b += step0) {
+      for (index_t m = start1; m < end1; m += step1) {
+        const index_t c = m / p.multiplier;
+        const index_t multi_index = m % p.multiplier;
+        auto filter_ptr =
+            filter_data + multi_index * p.in_channels * 25 + c * 25;
+        auto in_base = input_data + b * p.in_batch_size + c * p.in_image_size;
+        auto out_base = output_data + b * p.out_batch_size +
+            m * p.out_image_size;
+        index_t h, w;
+
+        // top
+        for (h = 0; h < p.valid_h_start; ++h) {
+          for (w = 0; w < p.out_width; ++w) {
+            DepthwiseConv2d5x5Pixel(in_base, filter_ptr, h, w,
+                                    h - p.pad_top, w - p.pad_left,
+                                    p.out_width, p.in_height, p.in_width,
+                                    out_base);
+          }
+        }
+
+        for (h = p.valid_h_start; h < p.valid_h_stop; ++h) {
+          // left
+          for (w = 0; w < p.valid_w_start; ++w) {
+            DepthwiseConv2d5x5Pixel(in_base, filter_ptr, h, w,
+                                    h - p.pad_top, w - p.pad_left,
+                                    p.out_width, p.in_height, p.in_width,
+                                    out_base);
+          }
+
+          for (w = p.valid_w_start; w + 3 < p.valid_w_stop; w += 4) {
+            // output (1 outch x 1 height x 4 width): vo
+            const index_t in_h = h - p.pad_top;
+            const index_t in_w = w - p.pad_left;
+            const T *in_ptr = in_base + in_h * p.in_width + in_w;
+            const index_t out_offset = h * p.out_width + w;
+            float32x4_t vo = vld1q(out_base + out_offset);
+
+            for (int r = 0; r < 5; ++r) {
+              // input (1 height x 5 slide): vi0..vi4 from two loads
+              const float32x4_t vi0 = vld1q(in_ptr);
+              const float32x4_t vin = vld1q(in_ptr + 4);
+              const T *f = filter_ptr + r * 5;
+              vo = vmlaq_n_f32(vo, vi0, f[0]);
+              vo = vmlaq_n_f32(vo, vextq_f32(vi0, vin, 1), f[1]);
+              vo = vmlaq_n_f32(vo, vextq_f32(vi0, vin, 2), f[2]);
+              vo = vmlaq_n_f32(vo, vextq_f32(vi0, vin, 3), f[3]);
+              vo = vmlaq_n_f32(vo, vin, f[4]);
+              in_ptr += p.in_width;
+            }
+            vst1q(out_base + out_offset, vo);
+          }  // w
+
+          // right
+          for (; w < p.out_width; ++w) {
+            DepthwiseConv2d5x5Pixel(in_base, filter_ptr, h, w,
+                                    h - p.pad_top, w - p.pad_left,
+                                    p.out_width, p.in_height, p.in_width,
+                                    out_base);
+          }
+        }  // h
+
+        // bottom
+        for (; h < p.out_height; ++h) {
+          for (w = 0; w < p.out_width; ++w) {
+            DepthwiseConv2d5x5Pixel(in_base, filter_ptr, h, w,
+                                    h - p.pad_top, w - p.pad_left,
+                                    p.out_width, p.in_height, p.in_width,
+                                    out_base);
+          }
+        }
+      }  // m
+    }    // b
+  }, 0, p.batch, 1, 0, p.out_channels, 1);  // threadpool
+
+  return MaceStatus::MACE_SUCCESS;
+}
+
+template<typename T>
+MaceStatus DepthwiseConv2dK5x5S2<T>::DoCompute(
+    const DepthwiseConvComputeParam &p, const T *filter_data,
+    const T *input_data, T *output_data) {
+  p.thread_pool.Compute2D([=](index_t start0, index_t end0, index_t step0,
+                              index_t start1, index_t end1, index_t step1) {
+    for (index_t b = start0; b < end0; b += step0) {
+      for (index_t m = start1; m < end1; m += step1) {
+        const index_t c = m / p.multiplier;
+        const index_t multi_index = m % p.multiplier;
+        auto filter_ptr =
+            filter_data + multi_index * p.in_channels * 25 + c * 25;
+        auto in_base = input_data + b * p.in_batch_size + c * p.in_image_size;
+        auto out_base = output_data + b * p.out_batch_size +
+            m * p.out_image_size;
+        index_t h, w;
+
+        // top
+        for (h = 0; h < p.valid_h_start; ++h) {
+          for (w = 0; w < p.out_width; ++w) {
+            DepthwiseConv2d5x5Pixel(in_base, filter_ptr, h, w,
+                                    h * 2 - p.pad_top, w * 2 - p.pad_left,
+                                    p.out_width, p.in_height, p.in_width,
+                                    out_base);
+          }
+        }
+
+        for (h = p.valid_h_start; h < p.valid_h_stop; ++h) {
+          // left
+          for (w = 0; w < p.valid_w_start; ++w) {
+            DepthwiseConv2d5x5Pixel(in_base, filter_ptr, h, w,
+                                    h * 2 - p.pad_top, w * 2 - p.pad_left,
+                                    p.out_width, p.in_height, p.in_width,
+                                    out_base);
+          }
+
+          for (w = p.valid_w_start; w + 3 < p.valid_w_stop; w += 4) {
+            const index_t in_h = h * 2 - p.pad_top;
+            const index_t in_w = w * 2 - p.pad_left;
+            const T *in_ptr = in_base + in_h * p.in_width + in_w;
+            const index_t out_offset = h * p.out_width + w;
+            float32x4_t vo = vld1q(out_base + out_offset);
+
+            for (int r = 0; r < 5; ++r) {
+              // deinterleaved even/odd taps over the strided row; the
+              // second pair only feeds vext, so the tail overread stays
+              // inside MACE_EXTRA_BUFFER_PAD_SIZE like the 3x3 kernel
+              const float32x4x2_t vi = vld2q(in_ptr);
+              const float32x4x2_t vin = vld2q(in_ptr + 8);
+              const T *f = filter_ptr + r * 5;
+              vo = vmlaq_n_f32(vo, vi.val[0], f[0]);
+              vo = vmlaq_n_f32(vo, vi.val[1], f[1]);
+              vo = vmlaq_n_f32(vo, vextq_f32(vi.val[0], vin.val[0], 1), f[2]);
+              vo = vmlaq_n_f32(vo, vextq_f32(vi.val[1], vin.val[1], 1), f[3]);
+              vo = vmlaq_n_f32(vo, vextq_f32(vi.val[0], vin.val[0], 2), f[4]);
+              in_ptr += p.in_width;
+            }
+            vst1q(out_base + out_offset, vo);
+          }  // w
+
+          // right
+          for (; w < p.out_width; ++w) {
+            DepthwiseConv2d5x5Pixel(in_base, filter_ptr, h, w,
+                                    h * 2 - p.pad_top, w * 2 - p.pad_left,
+                                    p.out_width, p.in_height, p.in_width,
+                                    out_base);
+          }
+        }  // h
+
+        // bottom
+        for (; h < p.out_height; ++h) {
+          for (w = 0; w < p.out_width; ++w) {
+            DepthwiseConv2d5x5Pixel(in_base, filter_ptr, h, w,
+                                    h * 2 - p.pad_top, w * 2 - p.pad_left,
+                                    p.out_width, p.in_height, p.in_width,
+                                    out_base);
+          }
+        }
+      }  // m
+    }    // b
+  }, 0, p.batch, 1, 0, p.out_channels, 1);  // threadpool
+
+  return MaceStatus::MACE_SUCCESS;
+}
+
+void RegisterDepthwiseConv2dK5x5Delegator(OpDelegatorRegistry *registry) {
+  MACE_REGISTER_DELEGATOR(
+      registry, DepthwiseConv2dK5x5S1<float>, delegator::DepthwiseConv2dParam,
+      MACE_DELEGATOR_KEY_EX(DepthwiseConv2d, DeviceType::CPU,
+                            float, ImplType::NEON, K5x5S1));
+  MACE_REGISTER_DELEGATOR(
+      registry, DepthwiseConv2dK5x5S2<float>, delegator::DepthwiseConv2dParam,
+      MACE_DELEGATOR_KEY_EX(DepthwiseConv2d, DeviceType::CPU,
+                            float, ImplType::NEON, K5x5S2));
+
+  MACE_REGISTER_BF16_DELEGATOR(
+      registry, DepthwiseConv2dK5x5S1<BFloat16>,
+      delegator::DepthwiseConv2dParam,
+      MACE_DELEGATOR_KEY_EX(DepthwiseConv2d, DeviceType::CPU,
+                            BFloat16, ImplType::NEON, K5x5S1));
+  MACE_REGISTER_BF16_DELEGATOR(
+      registry, DepthwiseConv2dK5x5S2<BFloat16>,
+      delegator::DepthwiseConv2dParam,
+      MACE_DELEGATOR_KEY_EX(DepthwiseConv2d, DeviceType::CPU,
+                            BFloat16, ImplType::NEON, K5x5S2));
+}
+
+}  // namespace arm
+}  // namespace ops
+}  // namespace mace
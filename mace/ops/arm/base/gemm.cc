@@ -525,6 +525,15 @@ MaceStatus Gemm<T>::Compute(
     const bool lhs_batched, const bool rhs_batched, Tensor *output) {
   MACE_CHECK(output->size() == batch * rows * cols,
              "Need resize output tensor before call gemm.");
+  // When only the lhs is batched and both it and the output are stored
+  // row-major, the batch dimension is contiguous with rows: run one
+  // taller GEMM instead of `batch` short ones, which amortizes rhs
+  // packing and keeps all cores busy when per-frame rows are small.
+  if (batch > 1 && lhs_batched && !rhs_batched &&
+      lhs_major == RowMajor && output_major == RowMajor) {
+    return Compute(context, lhs, rhs, 1, batch * rows, cols, depth,
+                   lhs_major, rhs_major, output_major, false, false, output);
+  }
   Tensor::MappingGuard lhs_guard(lhs);
   Tensor::MappingGuard rhs_guard(rhs);
   Tensor::MappingGuard output_guard(output);
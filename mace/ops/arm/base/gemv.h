@@ -15,6 +15,8 @@
 #ifndef MACE_OPS_ARM_BASE_GEMV_H_
 #define MACE_OPS_ARM_BASE_GEMV_H_
 
+#include <vector>
+
 #include "mace/core/ops/op_context.h"
 #include "mace/core/tensor.h"
 #include "mace/ops/delegator/gemv.h"
@@ -27,7 +29,10 @@ namespace arm {
 template<typename T>
 class Gemv : public delegator::Gemv {
  public:
-  explicit Gemv(const DelegatorParam &param) : delegator::Gemv(param) {}
+  explicit Gemv(const DelegatorParam &param)
+      : delegator::Gemv(param),
+        sparse_checked_(false),
+        use_sparse_(false) {}
   ~Gemv() {}
   // Always row-major after transpose
   MaceStatus Compute(
@@ -41,6 +46,16 @@ class Gemv : public delegator::Gemv {
       const bool lhs_batched,
       const bool rhs_batched,
       Tensor *output) override;
+
+ protected:
+  // CSR view of a constant, sufficiently sparse lhs, built lazily on
+  // the first run so pruned models skip their zero weights; dense
+  // weights keep using the packed NEON kernel.
+  bool sparse_checked_;
+  bool use_sparse_;
+  std::vector<int32_t> sparse_row_ptr_;
+  std::vector<int32_t> sparse_cols_;
+  std::vector<T> sparse_values_;
 };
 
 }  // namespace arm
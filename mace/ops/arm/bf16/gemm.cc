@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <utility>
 
+#include "mace/ops/arm/bf16/gemm_bf16dot.h"
 #include "mace/port/env.h"
 
 namespace mace {
@@ -35,6 +36,18 @@ void Gemm<BFloat16>::ComputeBlock(const BFloat16 *packed_lhs_data,
   const index_t depth_block_count = depth_padded / 4;
 
 #ifdef __aarch64__
+  // Armv8.6 cores: BFDOT micro-kernel works on the same packed layout
+  // with twice the MAC density of the widening ladder below; entered
+  // through a runtime feature check (see gemm_bf16dot.cc).
+  if (bf16::CpuSupportsBf16() && depth_block_count > 0) {
+    bf16::GemmBf16DotComputeBlock(
+        reinterpret_cast<const uint16_t *>(packed_lhs_data),
+        reinterpret_cast<const uint16_t *>(packed_rhs_data),
+        depth_padded,
+        reinterpret_cast<uint16_t *>(packed_output_data));
+    return;
+  }
+
   // Register layout: (8x4) x (4,8)
   //
   //                               +--------+--------+
@@ -0,0 +1,136 @@
+// Copyright 2020 The MACE Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// This translation unit is the only one compiled with the BF16 target
+// flags, so BFDOT never leaks into code running on pre-v8.6 cores;
+// everything else dispatches through CpuSupportsBf16().
+
+#include "mace/ops/arm/bf16/gemm_bf16dot.h"
+
+#include "mace/utils/macros.h"
+
+#if defined(MACE_ENABLE_MMLA) && \
+    defined(__ARM_FEATURE_BF16_VECTOR_ARITHMETIC) && defined(__aarch64__)
+#define MACE_BF16DOT_AVAILABLE
+#endif
+
+#ifdef MACE_BF16DOT_AVAILABLE
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#endif
+#endif
+
+namespace mace {
+namespace ops {
+namespace arm {
+namespace bf16 {
+
+#ifdef MACE_BF16DOT_AVAILABLE
+
+#ifndef HWCAP2_BF16
+#define HWCAP2_BF16 (1UL << 14)
+#endif
+
+bool CpuSupportsBf16() {
+#if defined(__linux__)
+  static const bool supported =
+      (getauxval(AT_HWCAP2) & HWCAP2_BF16) != 0;
+  return supported;
+#else
+  return false;
+#endif
+}
+
+void GemmBf16DotComputeBlock(const uint16_t *packed_lhs,
+                             const uint16_t *packed_rhs,
+                             const index_t depth_padded,
+                             uint16_t *packed_output) {
+  // accumulators: 8 output rows x (cols 0-3, cols 4-7), as in the
+  // widening kernel in gemm.cc
+  float32x4_t acc[8][2];
+  for (int r = 0; r < 8; ++r) {
+    acc[r][0] = vdupq_n_f32(0.f);
+    acc[r][1] = vdupq_n_f32(0.f);
+  }
+
+  const uint16_t *lhs_ptr = packed_lhs;
+  const uint16_t *rhs_ptr = packed_rhs;
+  for (index_t d = 0; d < depth_padded; d += 2) {
+    // per depth: lhs holds 8 contiguous rows, rhs 8 contiguous cols
+    const uint16x8_t l0 = vld1q_u16(lhs_ptr);       // rows 0-7 @ d
+    const uint16x8_t l1 = vld1q_u16(lhs_ptr + 8);   // rows 0-7 @ d+1
+    const uint16x8_t r0 = vld1q_u16(rhs_ptr);       // cols 0-7 @ d
+    const uint16x8_t r1 = vld1q_u16(rhs_ptr + 8);   // cols 0-7 @ d+1
+    // interleave to (d, d+1) pairs per lane for BFDOT
+    const uint16x8x2_t a = vzipq_u16(l0, l1);
+    const uint16x8x2_t b = vzipq_u16(r0, r1);
+    const bfloat16x8_t a_lo = vreinterpretq_bf16_u16(a.val[0]);  // rows 0-3
+    const bfloat16x8_t a_hi = vreinterpretq_bf16_u16(a.val[1]);  // rows 4-7
+    const bfloat16x8_t b_lo = vreinterpretq_bf16_u16(b.val[0]);  // cols 0-3
+    const bfloat16x8_t b_hi = vreinterpretq_bf16_u16(b.val[1]);  // cols 4-7
+
+    acc[0][0] = vbfdotq_laneq_f32(acc[0][0], b_lo, a_lo, 0);
+    acc[0][1] = vbfdotq_laneq_f32(acc[0][1], b_hi, a_lo, 0);
+    acc[1][0] = vbfdotq_laneq_f32(acc[1][0], b_lo, a_lo, 1);
+    acc[1][1] = vbfdotq_laneq_f32(acc[1][1], b_hi, a_lo, 1);
+    acc[2][0] = vbfdotq_laneq_f32(acc[2][0], b_lo, a_lo, 2);
+    acc[2][1] = vbfdotq_laneq_f32(acc[2][1], b_hi, a_lo, 2);
+    acc[3][0] = vbfdotq_laneq_f32(acc[3][0], b_lo, a_lo, 3);
+    acc[3][1] = vbfdotq_laneq_f32(acc[3][1], b_hi, a_lo, 3);
+    acc[4][0] = vbfdotq_laneq_f32(acc[4][0], b_lo, a_hi, 0);
+    acc[4][1] = vbfdotq_laneq_f32(acc[4][1], b_hi, a_hi, 0);
+    acc[5][0] = vbfdotq_laneq_f32(acc[5][0], b_lo, a_hi, 1);
+    acc[5][1] = vbfdotq_laneq_f32(acc[5][1], b_hi, a_hi, 1);
+    acc[6][0] = vbfdotq_laneq_f32(acc[6][0], b_lo, a_hi, 2);
+    acc[6][1] = vbfdotq_laneq_f32(acc[6][1], b_hi, a_hi, 2);
+    acc[7][0] = vbfdotq_laneq_f32(acc[7][0], b_lo, a_hi, 3);
+    acc[7][1] = vbfdotq_laneq_f32(acc[7][1], b_hi, a_hi, 3);
+
+    lhs_ptr += 16;
+    rhs_ptr += 16;
+  }
+
+  // narrow back to bf16 row-major, matching the widening kernel's shrn
+  for (int r = 0; r < 8; ++r) {
+    const uint16x4_t o_lo =
+        vshrn_n_u32(vreinterpretq_u32_f32(acc[r][0]), 16);
+    const uint16x4_t o_hi =
+        vshrn_n_u32(vreinterpretq_u32_f32(acc[r][1]), 16);
+    vst1q_u16(packed_output + r * 8, vcombine_u16(o_lo, o_hi));
+  }
+}
+
+#else  // !MACE_BF16DOT_AVAILABLE
+
+bool CpuSupportsBf16() {
+  return false;
+}
+
+void GemmBf16DotComputeBlock(const uint16_t *packed_lhs,
+                             const uint16_t *packed_rhs,
+                             const index_t depth_padded,
+                             uint16_t *packed_output) {
+  MACE_UNUSED(packed_lhs);
+  MACE_UNUSED(packed_rhs);
+  MACE_UNUSED(depth_padded);
+  MACE_UNUSED(packed_output);
+}
+
+#endif  // MACE_BF16DOT_AVAILABLE
+
+}  // namespace bf16
+}  // namespace arm
+}  // namespace ops
+}  // namespace mace
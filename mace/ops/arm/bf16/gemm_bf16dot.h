@@ -0,0 +1,46 @@
+// Copyright 2020 The MACE Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MACE_OPS_ARM_BF16_GEMM_BF16DOT_H_
+#define MACE_OPS_ARM_BF16_GEMM_BF16DOT_H_
+
+#include <cstdint>
+
+#include "mace/core/types.h"
+
+namespace mace {
+namespace ops {
+namespace arm {
+namespace bf16 {
+
+// Runtime check for the Armv8.6 BF16 extension (BFDOT/BFMMLA).
+// Compiled unconditionally and returns false when the binary was built
+// without MACE_ENABLE_MMLA, so callers keep a single dispatch site.
+bool CpuSupportsBf16();
+
+// 8x8 output block over depth_padded (a multiple of 4) using BFDOT on
+// the standard PackLhs/PackRhs layout (per depth: 8 contiguous lhs
+// rows / 8 contiguous rhs cols). Only valid after CpuSupportsBf16()
+// returned true. Pointers carry raw bf16 bits.
+void GemmBf16DotComputeBlock(const uint16_t *packed_lhs,
+                             const uint16_t *packed_rhs,
+                             const index_t depth_padded,
+                             uint16_t *packed_output);
+
+}  // namespace bf16
+}  // namespace arm
+}  // namespace ops
+}  // namespace mace
+
+#endif  // MACE_OPS_ARM_BF16_GEMM_BF16DOT_H_
@@ -16,6 +16,7 @@
 #include <algorithm>
 
 #include "mace/ops/arm/base/gemv.h"
+#include "mace/ops/arm/sve/gemv.h"
 #include "mace/utils/math.h"
 
 #if !defined(__aarch64__)
@@ -33,6 +34,12 @@ namespace mace {
 namespace ops {
 namespace arm {
 
+namespace {
+// below this fraction of zero weights the CSR bookkeeping costs more
+// than the skipped multiplies save
+constexpr float kGemvMinSparsity = 0.7f;
+}  // namespace
+
 template<>
 MaceStatus Gemv<float>::Compute(const OpContext *context,
                                 const Tensor *lhs,
@@ -62,6 +69,94 @@ MaceStatus Gemv<float>::Compute(const OpContext *context,
   }
   float *output_data = output->mutable_data<float>();
 
+  utils::ThreadPool
+      &sparse_thread_pool = context->device()->cpu_runtime()->thread_pool();
+  // Pruned models: probe constant weights once, and when they are
+  // sparse enough cache a CSR view so later runs skip the zero weights
+  // entirely. Dense weights fall through to the packed NEON kernel.
+  if (!sparse_checked_ && lhs->is_weight() && !lhs_batched) {
+    sparse_checked_ = true;
+    const index_t lhs_size = lhs_height * lhs_width;
+    index_t non_zeros = 0;
+    for (index_t i = 0; i < lhs_size; ++i) {
+      non_zeros += (lhs_data[i] != 0.f);
+    }
+    if (non_zeros <= lhs_size * (1.f - kGemvMinSparsity)) {
+      sparse_row_ptr_.resize(lhs_height + 1);
+      sparse_cols_.reserve(non_zeros);
+      sparse_values_.reserve(non_zeros);
+      for (index_t h = 0; h < lhs_height; ++h) {
+        sparse_row_ptr_[h] = static_cast<int32_t>(sparse_cols_.size());
+        const float *row = lhs_data + h * lhs_width;
+        for (index_t w = 0; w < lhs_width; ++w) {
+          if (row[w] != 0.f) {
+            sparse_cols_.push_back(static_cast<int32_t>(w));
+            sparse_values_.push_back(row[w]);
+          }
+        }
+      }
+      sparse_row_ptr_[lhs_height] = static_cast<int32_t>(sparse_cols_.size());
+      use_sparse_ = true;
+      VLOG(1) << "Gemv uses sparse weights: " << non_zeros
+              << " of " << lhs_size << " non-zero";
+    }
+  }
+  if (use_sparse_) {
+    const int32_t *row_ptr = sparse_row_ptr_.data();
+    const int32_t *cols = sparse_cols_.data();
+    const float *values = sparse_values_.data();
+    sparse_thread_pool.Compute2D(
+        [=](index_t start0, index_t end0, index_t step0,
+            index_t start1, index_t end1, index_t step1) {
+      for (index_t b = start0; b < end0; b += step0) {
+        const float *rhs_ptr =
+            rhs_data + static_cast<index_t>(rhs_batched) * b * lhs_width;
+        for (index_t h = start1; h < end1; h += step1) {
+          float acc0 = 0.f;
+          float acc1 = 0.f;
+          float acc2 = 0.f;
+          float acc3 = 0.f;
+          int32_t k = row_ptr[h];
+          const int32_t k_end = row_ptr[h + 1];
+          for (; k + 4 <= k_end; k += 4) {
+            acc0 += values[k] * rhs_ptr[cols[k]];
+            acc1 += values[k + 1] * rhs_ptr[cols[k + 1]];
+            acc2 += values[k + 2] * rhs_ptr[cols[k + 2]];
+            acc3 += values[k + 3] * rhs_ptr[cols[k + 3]];
+          }
+          for (; k < k_end; ++k) {
+            acc0 += values[k] * rhs_ptr[cols[k]];
+          }
+          float ret = acc0 + acc1 + acc2 + acc3;
+          if (bias_data != nullptr) {
+            ret += bias_data[h];
+          }
+          output_data[b * lhs_height + h] = ret;
+        }
+      }
+    }, 0, batch, 1, 0, lhs_height, 1);
+    return MaceStatus::MACE_SUCCESS;
+  }
+
+  // Armv9/SVE cores: scalable-vector rows kernel, entered through a
+  // runtime feature check (see arm/sve/gemv.cc)
+  if (sve::CpuSupportsSVE()) {
+    sparse_thread_pool.Compute2D(
+        [=](index_t start0, index_t end0, index_t step0,
+            index_t start1, index_t end1, index_t step1) {
+      for (index_t b = start0; b < end0; b += step0) {
+        const float *lhs_base = lhs_data
+            + static_cast<index_t>(lhs_batched) * b * lhs_height * lhs_width;
+        const float *rhs_base =
+            rhs_data + static_cast<index_t>(rhs_batched) * b * lhs_width;
+        MACE_UNUSED(step1);
+        sve::GemvRows(lhs_base, rhs_base, bias_data, lhs_width,
+                      start1, end1, output_data + b * lhs_height);
+      }
+    }, 0, batch, 1, 0, lhs_height, 1);
+    return MaceStatus::MACE_SUCCESS;
+  }
+
   const index_t h_block_size = 4;
   const index_t h_block_count = RoundUpDiv(lhs_height, h_block_size);
   const index_t w_block_size = 8;
@@ -88,6 +183,13 @@ MaceStatus Gemv<float>::Compute(const OpContext *context,
 
         const index_t h_block_len =
             std::min(h_block_size, lhs_height - h_start);
+#if defined(__GNUC__) || defined(__clang__)
+        // in-order little cores stall on L2 refills in the dot loops;
+        // start pulling the rows of this block before they are touched
+        for (index_t h = 0; h < h_block_len; ++h) {
+          __builtin_prefetch(lhs_ptr + h * lhs_width, 0, 1);
+        }
+#endif
 
 #ifdef MACE_GEMV_UNROLL
         if (h_block_len == 4) {
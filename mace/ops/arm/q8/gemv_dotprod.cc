@@ -0,0 +1,98 @@
+// Copyright 2020 The MACE Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// This translation unit is the only one compiled with
+// -march=armv8.2-a+dotprod, so UDOT never leaks into code that runs on
+// pre-v8.2 cores; everything else dispatches through
+// CpuSupportsDotProd().
+
+#include "mace/ops/arm/q8/gemv_dotprod.h"
+
+#include "mace/utils/macros.h"
+
+#if defined(MACE_ENABLE_DOTPROD) && defined(__ARM_FEATURE_DOTPROD) && \
+    defined(__aarch64__)
+#define MACE_Q8_DOTPROD_AVAILABLE
+#endif
+
+#ifdef MACE_Q8_DOTPROD_AVAILABLE
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#endif
+#endif
+
+namespace mace {
+namespace ops {
+namespace arm {
+namespace q8 {
+
+#ifdef MACE_Q8_DOTPROD_AVAILABLE
+
+#ifndef HWCAP_ASIMDDP
+#define HWCAP_ASIMDDP (1UL << 20)
+#endif
+
+bool CpuSupportsDotProd() {
+#if defined(__linux__)
+  static const bool supported =
+      (getauxval(AT_HWCAP) & HWCAP_ASIMDDP) != 0;
+  return supported;
+#else
+  return false;
+#endif
+}
+
+void GemvDotProdKernel(const uint8_t *lhs,
+                       const uint8_t *rhs,
+                       const index_t length,
+                       uint32_t *dot,
+                       uint32_t *sum_lhs) {
+  const uint8x16_t vones_u8 = vdupq_n_u8(1);
+  uint32x4_t vdot_u32 = vdupq_n_u32(0);
+  uint32x4_t vsum_lhs_u32 = vdupq_n_u32(0);
+  for (index_t i = 0; i < length; i += 16) {
+    const uint8x16_t vl_u8 = vld1q_u8(lhs + i);
+    const uint8x16_t vr_u8 = vld1q_u8(rhs + i);
+    vdot_u32 = vdotq_u32(vdot_u32, vl_u8, vr_u8);
+    vsum_lhs_u32 = vdotq_u32(vsum_lhs_u32, vl_u8, vones_u8);
+  }
+  *dot += vaddvq_u32(vdot_u32);
+  *sum_lhs += vaddvq_u32(vsum_lhs_u32);
+}
+
+#else  // !MACE_Q8_DOTPROD_AVAILABLE
+
+bool CpuSupportsDotProd() {
+  return false;
+}
+
+void GemvDotProdKernel(const uint8_t *lhs,
+                       const uint8_t *rhs,
+                       const index_t length,
+                       uint32_t *dot,
+                       uint32_t *sum_lhs) {
+  MACE_UNUSED(lhs);
+  MACE_UNUSED(rhs);
+  MACE_UNUSED(length);
+  MACE_UNUSED(dot);
+  MACE_UNUSED(sum_lhs);
+}
+
+#endif  // MACE_Q8_DOTPROD_AVAILABLE
+
+}  // namespace q8
+}  // namespace arm
+}  // namespace ops
+}  // namespace mace
@@ -0,0 +1,46 @@
+// Copyright 2020 The MACE Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MACE_OPS_ARM_Q8_GEMV_DOTPROD_H_
+#define MACE_OPS_ARM_Q8_GEMV_DOTPROD_H_
+
+#include <cstdint>
+
+#include "mace/core/types.h"
+
+namespace mace {
+namespace ops {
+namespace arm {
+namespace q8 {
+
+// Runtime check for the ARMv8.2 dot-product (UDOT) extension. This is
+// compiled unconditionally and returns false when the binary was built
+// without MACE_ENABLE_DOTPROD, so callers keep a single dispatch site.
+bool CpuSupportsDotProd();
+
+// Accumulate dot += sum(lhs[i] * rhs[i]) and sum_lhs += sum(lhs[i]) over
+// length elements (a multiple of 16) with UDOT. Only valid after
+// CpuSupportsDotProd() returned true.
+void GemvDotProdKernel(const uint8_t *lhs,
+                       const uint8_t *rhs,
+                       const index_t length,
+                       uint32_t *dot,
+                       uint32_t *sum_lhs);
+
+}  // namespace q8
+}  // namespace arm
+}  // namespace ops
+}  // namespace mace
+
+#endif  // MACE_OPS_ARM_Q8_GEMV_DOTPROD_H_
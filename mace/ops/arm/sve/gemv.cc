@@ -0,0 +1,109 @@
+// Copyright 2020 The MACE Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// This translation unit is the only one compiled with the SVE target
+// flags, so scalable-vector instructions never leak into code running
+// on pre-SVE cores; everything else dispatches through
+// CpuSupportsSVE().
+
+#include "mace/ops/arm/sve/gemv.h"
+
+#include "mace/utils/macros.h"
+
+#if defined(MACE_ENABLE_SVE) && defined(__ARM_FEATURE_SVE) && \
+    defined(__aarch64__)
+#define MACE_SVE_AVAILABLE
+#endif
+
+#ifdef MACE_SVE_AVAILABLE
+#include <arm_sve.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#endif
+#endif
+
+namespace mace {
+namespace ops {
+namespace arm {
+namespace sve {
+
+#ifdef MACE_SVE_AVAILABLE
+
+#ifndef HWCAP_SVE
+#define HWCAP_SVE (1UL << 22)
+#endif
+
+bool CpuSupportsSVE() {
+#if defined(__linux__)
+  static const bool supported =
+      (getauxval(AT_HWCAP) & HWCAP_SVE) != 0;
+  return supported;
+#else
+  return false;
+#endif
+}
+
+void GemvRows(const float *lhs,
+              const float *rhs,
+              const float *bias,
+              const index_t lhs_width,
+              const index_t h_start,
+              const index_t h_end,
+              float *output) {
+  for (index_t h = h_start; h < h_end; ++h) {
+    const float *lhs_ptr = lhs + h * lhs_width;
+    svfloat32_t vacc = svdup_n_f32(0.f);
+    for (index_t w = 0; w < lhs_width;
+         w += static_cast<index_t>(svcntw())) {
+      const svbool_t pg = svwhilelt_b32_s64(w, lhs_width);
+      const svfloat32_t vl = svld1_f32(pg, lhs_ptr + w);
+      const svfloat32_t vr = svld1_f32(pg, rhs + w);
+      vacc = svmla_f32_m(pg, vacc, vl, vr);
+    }
+    float ret = svaddv_f32(svptrue_b32(), vacc);
+    if (bias != nullptr) {
+      ret += bias[h];
+    }
+    output[h] = ret;
+  }
+}
+
+#else  // !MACE_SVE_AVAILABLE
+
+bool CpuSupportsSVE() {
+  return false;
+}
+
+void GemvRows(const float *lhs,
+              const float *rhs,
+              const float *bias,
+              const index_t lhs_width,
+              const index_t h_start,
+              const index_t h_end,
+              float *output) {
+  MACE_UNUSED(lhs);
+  MACE_UNUSED(rhs);
+  MACE_UNUSED(bias);
+  MACE_UNUSED(lhs_width);
+  MACE_UNUSED(h_start);
+  MACE_UNUSED(h_end);
+  MACE_UNUSED(output);
+}
+
+#endif  // MACE_SVE_AVAILABLE
+
+}  // namespace sve
+}  // namespace arm
+}  // namespace ops
+}  // namespace mace
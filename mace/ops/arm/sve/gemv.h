@@ -0,0 +1,50 @@
+// Copyright 2020 The MACE Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// First member of the SVE kernel family (see arm/q8/gemv_dotprod.* for
+// the dispatch pattern): scalable-vector kernels live in arm/sve/, are
+// compiled with the SVE target flags in isolation, and are entered
+// through a runtime CPU feature check so existing delegators pick them
+// up transparently.
+
+#ifndef MACE_OPS_ARM_SVE_GEMV_H_
+#define MACE_OPS_ARM_SVE_GEMV_H_
+
+#include "mace/core/types.h"
+
+namespace mace {
+namespace ops {
+namespace arm {
+namespace sve {
+
+// Runtime check for SVE. Compiled unconditionally and returns false
+// when the binary was built without MACE_ENABLE_SVE.
+bool CpuSupportsSVE();
+
+// output[h] = dot(lhs[h, :], rhs) + bias[h] for h in [h_start, h_end).
+// Only valid after CpuSupportsSVE() returned true.
+void GemvRows(const float *lhs,
+              const float *rhs,
+              const float *bias,
+              const index_t lhs_width,
+              const index_t h_start,
+              const index_t h_end,
+              float *output);
+
+}  // namespace sve
+}  // namespace arm
+}  // namespace ops
+}  // namespace mace
+
+#endif  // MACE_OPS_ARM_SVE_GEMV_H_
@@ -58,6 +58,8 @@ class CastOp : public Operation {
 void RegisterCast(OpRegistry *op_registry) {
   MACE_REGISTER_OP(op_registry, "Cast", CastOp, DeviceType::CPU, float);
   MACE_REGISTER_OP(op_registry, "Cast", CastOp, DeviceType::CPU, int32_t);
+  // precision boundaries in mixed-precision graphs
+  MACE_REGISTER_BF16_OP(op_registry, "Cast", CastOp, DeviceType::CPU);
 #if defined(MACE_ENABLE_NEON) && defined(__ANDROID__)
   MACE_REGISTER_OP(op_registry, "Cast", CastOp,
                    DeviceType::CPU, float16_t);
@@ -16,6 +16,7 @@
 
 #include "mace/core/ops/operator.h"
 #include "mace/core/registry/ops_registry.h"
+#include "mace/core/runtime/cpu/cpu_runtime.h"
 #ifdef MACE_ENABLE_OPENCL
 #include "mace/ops/opencl/image/channel_shuffle.h"
 #endif  // MACE_ENABLE_OPENCL
@@ -75,6 +76,58 @@ class ChannelShuffleOp<DeviceType::CPU, T> : public Operation {
   const int groups_;
 };
 
+#ifdef MACE_ENABLE_QUANTIZE
+// quantized graphs run NHWC, so the shuffle walks the innermost axis
+template<>
+class ChannelShuffleOp<DeviceType::CPU, uint8_t> : public Operation {
+ public:
+  explicit ChannelShuffleOp(OpConstructContext *context)
+      : Operation(context),
+        groups_(Operation::GetOptionalArg<int>("group", 1)) {}
+
+  MaceStatus Run(OpContext *context) override {
+    MACE_UNUSED(context);
+    const Tensor *input = this->Input(0);
+    Tensor *output = this->Output(0);
+    MACE_CHECK(input->dim(3) % groups_ == 0,
+               "input channels must be an integral multiple of group. ",
+               input->dim(3));
+    MACE_RETURN_IF_ERROR(output->ResizeLike(input));
+    output->SetScale(input->scale());
+    output->SetZeroPoint(input->zero_point());
+
+    Tensor::MappingGuard input_guard(input);
+    Tensor::MappingGuard output_guard(output);
+    const uint8_t *input_ptr = input->data<uint8_t>();
+    uint8_t *output_ptr = output->mutable_data<uint8_t>();
+
+    const index_t spatial_size = input->dim(0) * input->dim(1) * input->dim(2);
+    const index_t channels = input->dim(3);
+    const index_t channels_per_group = channels / groups_;
+    const int groups = groups_;
+
+    utils::ThreadPool &thread_pool =
+        context->device()->cpu_runtime()->thread_pool();
+    thread_pool.Compute1D([=](index_t start, index_t end, index_t step) {
+      for (index_t i = start; i < end; i += step) {
+        const uint8_t *in_ptr = input_ptr + i * channels;
+        uint8_t *out_ptr = output_ptr + i * channels;
+        for (index_t c = 0; c < channels; ++c) {
+          const index_t g = c % groups;
+          const index_t idx = c / groups;
+          out_ptr[c] = in_ptr[g * channels_per_group + idx];
+        }
+      }
+    }, 0, spatial_size, 1);
+
+    return MaceStatus::MACE_SUCCESS;
+  }
+
+ private:
+  const int groups_;
+};
+#endif  // MACE_ENABLE_QUANTIZE
+
 #ifdef MACE_ENABLE_OPENCL
 template<>
 class ChannelShuffleOp<DeviceType::GPU, float> : public Operation {
@@ -105,6 +158,13 @@ void RegisterChannelShuffle(OpRegistry *op_registry) {
   MACE_REGISTER_BF16_OP(op_registry, "ChannelShuffle",
                         ChannelShuffleOp, DeviceType::CPU);
 
+#ifdef MACE_ENABLE_QUANTIZE
+  // pure data movement: the generic kernel handles u8 natively, so
+  // quantized graphs do not bounce through float here
+  MACE_REGISTER_OP(op_registry, "ChannelShuffle",
+                   ChannelShuffleOp, DeviceType::CPU, uint8_t);
+#endif  // MACE_ENABLE_QUANTIZE
+
   MACE_REGISTER_GPU_OP(op_registry, "ChannelShuffle", ChannelShuffleOp);
 
   MACE_REGISTER_OP_CONDITION(
@@ -26,6 +26,41 @@
 namespace mace {
 namespace ops {
 
+// 4x4 micro tile of a 2D transpose; the float overload stays entirely
+// in registers
+template<typename SrcT, typename DstT>
+inline void Transpose4x4(const SrcT *src, const index_t src_stride,
+                         DstT *dst, const index_t dst_stride) {
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      dst[j * dst_stride + i] = src[i * src_stride + j];
+    }
+  }
+}
+
+#if defined(MACE_ENABLE_NEON)
+inline void Transpose4x4(const float *src, const index_t src_stride,
+                         float *dst, const index_t dst_stride) {
+  const float32x4_t v0 = vld1q_f32(src);
+  const float32x4_t v1 = vld1q_f32(src + src_stride);
+  const float32x4_t v2 = vld1q_f32(src + 2 * src_stride);
+  const float32x4_t v3 = vld1q_f32(src + 3 * src_stride);
+  const float32x4x2_t t01 = vtrnq_f32(v0, v1);
+  const float32x4x2_t t23 = vtrnq_f32(v2, v3);
+  vst1q_f32(dst, vcombine_f32(vget_low_f32(t01.val[0]),
+                              vget_low_f32(t23.val[0])));
+  vst1q_f32(dst + dst_stride,
+            vcombine_f32(vget_low_f32(t01.val[1]),
+                         vget_low_f32(t23.val[1])));
+  vst1q_f32(dst + 2 * dst_stride,
+            vcombine_f32(vget_high_f32(t01.val[0]),
+                         vget_high_f32(t23.val[0])));
+  vst1q_f32(dst + 3 * dst_stride,
+            vcombine_f32(vget_high_f32(t01.val[1]),
+                         vget_high_f32(t23.val[1])));
+}
+#endif  // MACE_ENABLE_NEON
+
 template<typename SrcT, typename DstT>
 void TransposeNHWCToNCHWC3(utils::ThreadPool *thread_pool,
                            const SrcT *input,
@@ -185,7 +220,22 @@ MaceStatus Transpose(utils::ThreadPool *thread_pool,
         for (index_t j = start1; j < end1; j += step1) {
           index_t end_i = std::min(i + tile_size, height);
           index_t end_j = std::min(j + tile_size, width);
-          for (index_t tile_i = i; tile_i < end_i; ++tile_i) {
+          // 4x4 micro tiles within the cache tile, scalar remainders
+          const index_t vec_end_i = i + ((end_i - i) & ~3);
+          const index_t vec_end_j = j + ((end_j - j) & ~3);
+          for (index_t tile_i = i; tile_i < vec_end_i; tile_i += 4) {
+            for (index_t tile_j = j; tile_j < vec_end_j; tile_j += 4) {
+              Transpose4x4(input + tile_i * stride_j + tile_j, stride_j,
+                           output + tile_j * stride_i + tile_i, stride_i);
+            }
+            for (index_t tile_j = vec_end_j; tile_j < end_j; ++tile_j) {
+              for (index_t ii = tile_i; ii < tile_i + 4; ++ii) {
+                output[tile_j * stride_i + ii] =
+                    input[ii * stride_j + tile_j];
+              }
+            }
+          }
+          for (index_t tile_i = vec_end_i; tile_i < end_i; ++tile_i) {
             for (index_t tile_j = j; tile_j < end_j; ++tile_j) {
               output[tile_j * stride_i + tile_i] =
                   input[tile_i * stride_j + tile_j];
@@ -225,27 +275,32 @@ MaceStatus Transpose(utils::ThreadPool *thread_pool,
       index_t tile_size = std::max(static_cast<index_t>(1),
                                    static_cast<index_t>(std::sqrt(
                                        8 * 1024 / channel)));
-      for (index_t b = 0; b < input_shape[0]; ++b) {
-        auto input_offset = input + b * batch_size;
-        auto output_offset = output + b * batch_size;
-        for (index_t i = 0; i < height; i += tile_size) {
-          for (index_t j = 0; j < width; j += tile_size) {
-            index_t end_i = std::min(i + tile_size, height);
-            index_t end_j = std::min(j + tile_size, width);
-            for (index_t tile_i = i; tile_i < end_i; ++tile_i) {
-              for (index_t tile_j = j; tile_j < end_j; ++tile_j) {
-                auto output_ptr =
-                    output_offset + (tile_j * stride_i + tile_i) * channel;
-                auto input_ptr =
-                    input_offset + (tile_i * stride_j + tile_j) * channel;
-                for (index_t k = 0; k < channel; ++k) {
-                  output_ptr[k] = input_ptr[k];
+      // parallelize over (batch, row tiles); each tile only touches its
+      // own output rows
+      thread_pool->Compute2D([=](index_t start0, index_t end0, index_t step0,
+                                 index_t start1, index_t end1, index_t step1) {
+        for (index_t b = start0; b < end0; b += step0) {
+          auto input_offset = input + b * batch_size;
+          auto output_offset = output + b * batch_size;
+          for (index_t i = start1; i < end1; i += step1) {
+            for (index_t j = 0; j < width; j += tile_size) {
+              index_t end_i = std::min(i + tile_size, height);
+              index_t end_j = std::min(j + tile_size, width);
+              for (index_t tile_i = i; tile_i < end_i; ++tile_i) {
+                for (index_t tile_j = j; tile_j < end_j; ++tile_j) {
+                  auto output_ptr =
+                      output_offset + (tile_j * stride_i + tile_i) * channel;
+                  auto input_ptr =
+                      input_offset + (tile_i * stride_j + tile_j) * channel;
+                  for (index_t k = 0; k < channel; ++k) {
+                    output_ptr[k] = input_ptr[k];
+                  }
                 }
               }
             }
           }
         }
-      }
+      }, 0, input_shape[0], 1, 0, height, tile_size);
     } else {
       std::vector<index_t>
           in_stride{input_shape[1] * input_shape[2] * input_shape[3],
@@ -292,10 +347,28 @@ MaceStatus Transpose(utils::ThreadPool *thread_pool,
             for (index_t j = start1; j < end1; j += step1) {
               index_t end_i = std::min(i + tile_size, height);
               index_t end_j = std::min(j + tile_size, width);
-              for (index_t tile_i = i; tile_i < end_i; ++tile_i) {
+              const index_t vec_end_i = i + ((end_i - i) & ~3);
+              const index_t vec_end_j = j + ((end_j - j) & ~3);
+              const SrcT *input_b = input + b * stride_hw;
+              DstT *output_b = output + b * stride_hw;
+              for (index_t tile_i = i; tile_i < vec_end_i; tile_i += 4) {
+                for (index_t tile_j = j; tile_j < vec_end_j; tile_j += 4) {
+                  Transpose4x4(input_b + tile_i * stride_w + tile_j,
+                               stride_w,
+                               output_b + tile_j * stride_h + tile_i,
+                               stride_h);
+                }
+                for (index_t tile_j = vec_end_j; tile_j < end_j; ++tile_j) {
+                  for (index_t ii = tile_i; ii < tile_i + 4; ++ii) {
+                    output_b[tile_j * stride_h + ii] =
+                        input_b[ii * stride_w + tile_j];
+                  }
+                }
+              }
+              for (index_t tile_i = vec_end_i; tile_i < end_i; ++tile_i) {
                 for (index_t tile_j = j; tile_j < end_j; ++tile_j) {
-                  output[b * stride_hw + tile_j * stride_h + tile_i] =
-                      input[b * stride_hw + tile_i * stride_w + tile_j];
+                  output_b[tile_j * stride_h + tile_i] =
+                      input_b[tile_i * stride_w + tile_j];
                 }
               }
             }
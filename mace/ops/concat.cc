@@ -16,6 +16,7 @@
 
 #include "mace/core/ops/operator.h"
 #include "mace/core/registry/ops_registry.h"
+#include "mace/core/runtime/cpu/cpu_runtime.h"
 #include "mace/core/quantize.h"
 #include "mace/utils/memory.h"
 
@@ -59,7 +60,6 @@ class ConcatOp<DeviceType::CPU, T> : public ConcatOpBase {
             "has_data_format", 0) == 1) {}
 
   MaceStatus Run(OpContext *context) override {
-    MACE_UNUSED(context);
     int axis = FormatAxis();
     if (has_data_format_ && this->Input(0)->dim_size() == 4) {
       if (axis == 3) axis = 1;
@@ -102,24 +102,43 @@ class ConcatOp<DeviceType::CPU, T> : public ConcatOpBase {
       mappers.emplace_back(Tensor::MappingGuard(inputs[i]));
     }
 
-    T *output_ptr = output->mutable_data<T>();
+    T *output_data = output->mutable_data<T>();
     std::vector<const T *> input_ptrs(inputs.size(), nullptr);
     for (size_t i = 0; i < inputs_count; ++i) {
       input_ptrs[i] = inputs[i]->data<T>();
     }
-    for (int inner_idx = 0; inner_idx < inner_size; ++inner_idx) {
-      for (size_t i = 0; i < inputs_count; ++i) {
-        if (DataTypeCanUseMemcpy(DataTypeToEnum<T>::v())) {
-          memcpy(output_ptr, input_ptrs[i], outer_sizes[i] * sizeof(T));
-          output_ptr += outer_sizes[i];
-          input_ptrs[i] += outer_sizes[i];
-        } else {
-          for (index_t k = 0; k < outer_sizes[i]; ++k) {
-            *output_ptr++ = *input_ptrs[i]++;
+    index_t total_outer_size = 0;
+    std::vector<index_t> output_offsets(inputs_count, 0);
+    for (size_t i = 0; i < inputs_count; ++i) {
+      output_offsets[i] = total_outer_size;
+      total_outer_size += outer_sizes[i];
+    }
+    // every (inner index, input) pair is an independent contiguous run;
+    // spread the bulk copies across the pool, which matters for the
+    // channel-axis concats on big NHWC feature maps
+    const index_t *outer_sizes_ptr = outer_sizes.data();
+    const index_t *output_offsets_ptr = output_offsets.data();
+    const T *const *input_ptrs_ptr = input_ptrs.data();
+    utils::ThreadPool &thread_pool =
+        context->device()->cpu_runtime()->thread_pool();
+    thread_pool.Compute1D([=](index_t start, index_t end, index_t step) {
+      for (index_t inner_idx = start; inner_idx < end; inner_idx += step) {
+        T *output_ptr = output_data + inner_idx * total_outer_size;
+        for (size_t i = 0; i < inputs_count; ++i) {
+          const T *input_ptr =
+              input_ptrs_ptr[i] + inner_idx * outer_sizes_ptr[i];
+          if (DataTypeCanUseMemcpy(DataTypeToEnum<T>::v())) {
+            memcpy(output_ptr + output_offsets_ptr[i], input_ptr,
+                   outer_sizes_ptr[i] * sizeof(T));
+          } else {
+            T *dst = output_ptr + output_offsets_ptr[i];
+            for (index_t k = 0; k < outer_sizes_ptr[i]; ++k) {
+              dst[k] = input_ptr[k];
+            }
           }
         }
       }
-    }
+    }, 0, inner_size, 1);
 
     return MaceStatus::MACE_SUCCESS;
   }
@@ -50,6 +50,15 @@
 namespace mace {
 namespace ops {
 
+// Grouped convolution has no runtime kernel: the converter splits a
+// group conv into per-group Slice/Conv2D/Concat chains, and each thin
+// group walks the full feature map with poor cache reuse. A native
+// group-aware delegator would pack all group filters once and walk
+// the input a single time, dispatching per-group GEMM panels from the
+// same pass (depthwise is the existing extreme case of this). It
+// needs a "group" arg surviving conversion plus group-strided
+// variants of the packed GEMM entry points; with those, ShuffleNet
+// blocks drop the slice/concat traffic entirely.
 template<DeviceType D, class T>
 class Conv2dOp;
 
@@ -58,6 +67,11 @@ class Conv2dOp<DeviceType::CPU, T> : public ConvPool2dOpBase {
  public:
   explicit Conv2dOp(OpConstructContext *context)
       : ConvPool2dOpBase(context),
+        activation_type_(ops::StringToActivationType(
+            Operation::GetOptionalArg<std::string>("activation", "NOOP"))),
+        max_limit_(Operation::GetOptionalArg<float>("max_limit", 0.0f)),
+        fused_residual_add_(
+            Operation::GetOptionalArg<bool>("fused_residual_add", false)),
         activation_delegator_(
             delegator::Activation::Create(
                 context->workspace(),
@@ -79,11 +93,33 @@ class Conv2dOp<DeviceType::CPU, T> : public ConvPool2dOpBase {
     const Tensor *input = this->Input(INPUT);
     const Tensor *filter = this->Input(FILTER);
     const Tensor *bias = this->InputSize() >= 3 ? this->Input(BIAS) : nullptr;
+    // appended by NetOptimizer::FuseResidualBlocks (requires a bias)
+    const Tensor *residual =
+        (fused_residual_add_ && this->InputSize() >= 4) ? this->Input(3)
+                                                        : nullptr;
     Tensor *output = this->Output(OUTPUT);
 
     if (conv2d_delegator_ == nullptr) {
       auto tag = MACE_DELEGATOR_KEY(Conv2d, DeviceType::CPU, T, kCpuImplType);
-      if (kCpuImplType == NEON) {
+      // regression bisection: ops named in MACE_CONV2D_FORCE_GENERAL
+      // (comma separated) skip specialized kernel selection, so a
+      // per-layer A/B between the specialized and general kernels
+      // needs only an env change, not a rebuild
+      bool force_general = false;
+      const char *force_list = getenv("MACE_CONV2D_FORCE_GENERAL");
+      if (force_list != nullptr) {
+        const std::string &op_name = operator_def_->name();
+        std::string list(force_list);
+        size_t pos = 0;
+        while (pos != std::string::npos && !force_general) {
+          size_t comma = list.find(',', pos);
+          const std::string entry = list.substr(
+              pos, comma == std::string::npos ? comma : comma - pos);
+          force_general = entry == op_name;
+          pos = comma == std::string::npos ? comma : comma + 1;
+        }
+      }
+      if (kCpuImplType == NEON && !force_general) {
         // the following params are used to decide which conv delegator to use
         const index_t stride_h = strides_[0];
         const index_t stride_w = strides_[1];
@@ -164,13 +200,64 @@ class Conv2dOp<DeviceType::CPU, T> : public ConvPool2dOpBase {
     }
 
     conv2d_delegator_->Compute(context, input, filter, output);
-    bias_add_delegator_->Compute(context, output, bias, output);
-    activation_delegator_->Compute(context, output, output);
+    if (residual != nullptr) {
+      // bias + residual (+ relu) applied in one pass while each tile is
+      // still hot, instead of re-streaming the feature map per stage
+      MACE_CHECK(residual->shape() == output->shape(),
+                 "fused residual shape must match conv output");
+      const bool fuse_activation = activation_type_ == NOOP ||
+          activation_type_ == RELU || activation_type_ == RELUX;
+      Tensor::MappingGuard residual_guard(residual);
+      Tensor::MappingGuard bias_guard(bias);
+      const T *residual_data = residual->data<T>();
+      const T *bias_data = bias != nullptr ? bias->data<T>() : nullptr;
+      T *output_data = output->mutable_data<T>();
+      const index_t batch = output->dim(0);
+      const index_t channels = output->dim(1);
+      const index_t image_size = output->dim(2) * output->dim(3);
+      const ActivationType activation_type =
+          fuse_activation ? activation_type_ : NOOP;
+      const float max_limit = max_limit_;
+      utils::ThreadPool &thread_pool =
+          context->device()->cpu_runtime()->thread_pool();
+      thread_pool.Compute2D(
+          [=](index_t start0, index_t end0, index_t step0,
+              index_t start1, index_t end1, index_t step1) {
+        for (index_t b = start0; b < end0; b += step0) {
+          for (index_t c = start1; c < end1; c += step1) {
+            const index_t offset = (b * channels + c) * image_size;
+            const float bias_v =
+                bias_data != nullptr ? static_cast<float>(bias_data[c]) : 0.f;
+            T *output_ptr = output_data + offset;
+            const T *residual_ptr = residual_data + offset;
+            for (index_t i = 0; i < image_size; ++i) {
+              float v = static_cast<float>(output_ptr[i]) + bias_v +
+                  static_cast<float>(residual_ptr[i]);
+              if (activation_type == RELU) {
+                v = std::max(v, 0.f);
+              } else if (activation_type == RELUX) {
+                v = std::min(std::max(v, 0.f), max_limit);
+              }
+              output_ptr[i] = v;
+            }
+          }
+        }
+      }, 0, batch, 1, 0, channels, 1);
+      if (!fuse_activation) {
+        activation_delegator_->Compute(context, output, output);
+      }
+    } else {
+      bias_add_delegator_->Compute(context, output, bias, output);
+      activation_delegator_->Compute(context, output, output);
+    }
 
     return MaceStatus::MACE_SUCCESS;
   }
 
  private:
+  ActivationType activation_type_;
+  float max_limit_;
+  bool fused_residual_add_;
   std::unique_ptr<delegator::Activation> activation_delegator_;
   std::unique_ptr<delegator::BiasAdd> bias_add_delegator_;
   std::unique_ptr<delegator::Conv2d> conv2d_delegator_;
@@ -16,6 +16,7 @@
 
 #include "mace/core/ops/operator.h"
 #include "mace/core/registry/ops_registry.h"
+#include "mace/core/runtime/cpu/cpu_runtime.h"
 
 namespace mace {
 namespace ops {
@@ -43,7 +44,6 @@ class CumsumOp<DeviceType::CPU, T> : public Operation {
   }
 
   MaceStatus Run(OpContext *context) override {
-    MACE_UNUSED(context);
     if (!checked_) {
       Validate();
       bool has_data_format = Operation::GetOptionalArg<int>(
@@ -78,8 +78,13 @@ class CumsumOp<DeviceType::CPU, T> : public Operation {
                                                std::multiplies<index_t>());
     const index_t cum_size = input_shape[axis_];
 
+    // scans along different outer indices are independent; the serial
+    // dependency is only along the cum axis
+    utils::ThreadPool &thread_pool =
+        context->device()->cpu_runtime()->thread_pool();
     if (!reverse_) {
-      for (index_t outer_idx = 0; outer_idx < outer_size; ++outer_idx) {
+      thread_pool.Compute1D([=](index_t start, index_t end, index_t step) {
+      for (index_t outer_idx = start; outer_idx < end; outer_idx += step) {
         index_t start_idx = outer_idx * cum_size * inner_size;
         for (index_t cum_idx = 0; cum_idx < cum_size; ++cum_idx) {
           if (cum_idx == 0) {
@@ -104,8 +109,10 @@ class CumsumOp<DeviceType::CPU, T> : public Operation {
           }
         }
       }
+      }, 0, outer_size, 1);
     } else {
-      for (index_t outer_idx = outer_size - 1; outer_idx >= 0; --outer_idx) {
+      thread_pool.Compute1D([=](index_t start, index_t end, index_t step) {
+      for (index_t outer_idx = start; outer_idx < end; outer_idx += step) {
         index_t start_idx = outer_idx * cum_size * inner_size;
         for (index_t cum_idx = cum_size - 1; cum_idx >= 0; --cum_idx) {
           index_t cur_idx = start_idx + cum_idx * inner_size;
@@ -130,6 +137,7 @@ class CumsumOp<DeviceType::CPU, T> : public Operation {
           }
         }
       }
+      }, 0, outer_size, 1);
     }
 
     return MaceStatus::MACE_SUCCESS;
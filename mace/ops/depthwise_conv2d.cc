@@ -60,6 +60,15 @@ class DepthwiseConv2dOpBase : public ConvPool2dOpBase {
   const float activation_coefficient_;
 };
 
+// MobileNet blocks run depthwise 3x3 then pointwise 1x1 as separate
+// ops, writing the full intermediate map between them. The fused form
+// computes a few depthwise output rows into an L1-resident ring and
+// immediately consumes them as the K-slice of the 1x1 GEMM. The 1x1
+// kernel side is ready for that (it walks input rows linearly); what
+// is missing is a row-granular producer interface on the depthwise
+// delegator -- today its Compute emits the whole map. Splitting that
+// interface is the enabler, and the fusion pass itself can then follow
+// FuseResidualBlocks' pattern in NetOptimizer.
 template<DeviceType D, class T>
 class DepthwiseConv2dOp;
 
@@ -112,6 +121,16 @@ class DepthwiseConv2dOp<DeviceType::CPU, T> : public DepthwiseConv2dOpBase {
             && dilation_h == 1 && dilation_w == 1) {
           tag = MACE_DELEGATOR_KEY_EX(DepthwiseConv2d, DeviceType::CPU, T,
                                       kCpuImplType, K3x3S2);
+        } else if (filter_h == 5 && filter_w == 5 && stride_h == 1
+            && stride_w == 1
+            && dilation_h == 1 && dilation_w == 1) {
+          tag = MACE_DELEGATOR_KEY_EX(DepthwiseConv2d, DeviceType::CPU, T,
+                                      kCpuImplType, K5x5S1);
+        } else if (filter_h == 5 && filter_w == 5 && stride_h == 2
+            && stride_w == 2
+            && dilation_h == 1 && dilation_w == 1) {
+          tag = MACE_DELEGATOR_KEY_EX(DepthwiseConv2d, DeviceType::CPU, T,
+                                      kCpuImplType, K5x5S2);
         }
       }
       delegator::Conv2dParam param(strides_, dilations_,
@@ -47,6 +47,15 @@
 namespace mace {
 namespace ops {
 
+// Streaming clients feed cache tensors (cell/output history) back as
+// model inputs through the public API each chunk. Since MaceTensor
+// grew zero-copy support, that loop is copy-free on CPU: bind one
+// zero-copy tensor as both the cache output and the next call's cache
+// input and the engine reads/writes it in place. True in-engine state
+// (cache tensors persisted in the Workspace across Run calls, with an
+// explicit ResetState API) would also drop the cache from the public
+// interface, but it changes the op contract -- outputs become carried
+// state -- and needs converter awareness of state edges.
 template<DeviceType D, typename T>
 class DynamicLSTMOp;
 
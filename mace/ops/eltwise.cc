@@ -30,6 +30,7 @@
 #include "mace/core/ops/operator.h"
 #include "mace/core/registry/ops_registry.h"
 #include "mace/core/tensor.h"
+#include "mace/ops/activation.h"
 #include "mace/utils/memory.h"
 #include "mace/core/quantize.h"
 #ifdef MACE_ENABLE_OPENCL
@@ -63,6 +64,15 @@ inline void IncreaseIndex(const std::vector<index_t> &shape,
   }
 }
 
+// Shape-specialized fast paths already exist below for the profiled
+// hot cases: TensorEltwise (same shapes), TensorScalarEltwise
+// (scalar-vs-tensor), TensorEltwisePerChannel (per-channel-vs-tensor)
+// and TensorBroadcastEltwise (trailing-dims broadcast), all threaded
+// with contiguous inner loops the compiler vectorizes. Only shapes
+// matching none of those fall into this general index-arithmetic
+// walker, whose IncreaseIndex iterator is inherently serial; graphs
+// hitting it at a measurable rate should get their shape added to the
+// specialized set instead of this path being tuned.
 template<typename T, typename DstType>
 inline void TensorGeneralBroadcastEltwise(
     const OpContext *context,
@@ -1196,8 +1206,16 @@ class EltwiseOp<DeviceType::GPU, float> : public Operation {
     MemoryType mem_type;
     if (context->GetOpMemoryType() == MemoryType::GPU_IMAGE) {
       mem_type = MemoryType::GPU_IMAGE;
+      // set by the pointwise-chain fusion pass in NetOptimizer
+      auto activation = ops::StringToActivationType(
+          Operation::GetOptionalArg<std::string>("activation", "NOOP"));
+      auto relux_max_limit = Operation::GetOptionalArg<float>(
+          "max_limit", 0.0f);
+      auto activation_coefficient = Operation::GetOptionalArg<float>(
+          "activation_coefficient", 0.0f);
       kernel_ = make_unique<opencl::image::EltwiseKernel>(
-          type, coeff, scalar_input, scalar_input_index);
+          type, coeff, scalar_input, scalar_input_index,
+          activation, relux_max_limit, activation_coefficient);
     } else {
       MACE_NOT_IMPLEMENTED;
     }
@@ -1245,6 +1263,9 @@ class EltwiseOp<DeviceType::GPU, float> : public Operation {
 void RegisterEltwise(OpRegistry *op_registry) {
   MACE_REGISTER_OP(op_registry, "Eltwise", EltwiseOp, DeviceType::CPU, float);
   MACE_REGISTER_BF16_OP(op_registry, "Eltwise", EltwiseOp, DeviceType::CPU);
+  // with -march=armv8.2-a+fp16 the generic kernel's arithmetic stays
+  // in half precision end to end
+  MACE_REGISTER_FP16_OP(op_registry, "Eltwise", EltwiseOp, DeviceType::CPU);
 
   MACE_REGISTER_OP(op_registry, "Eltwise", EltwiseOp,
                    DeviceType::CPU, int32_t);
@@ -96,6 +96,19 @@ class FullyConnectedOp<DeviceType::CPU, T> : public FullyConnectedOpBase {
     const index_t input_size = weight->dim(1) * weight->dim(2) * weight->dim(3);
     const index_t output_size = weight->dim(0);
 
+#ifdef MACE_ENABLE_QUANTIZE
+    // dynamic-range mode: int8 weights in an otherwise float graph;
+    // activations are quantized on the fly per run
+    if (DataTypeToEnum<T>::value == DataType::DT_FLOAT &&
+        weight->dtype() == DataType::DT_UINT8) {
+      MACE_RETURN_IF_ERROR(RunDynamicQuant(context, input, weight, bias,
+                                           batch, input_size, output_size,
+                                           output));
+      activation_delegator_->Compute(context, output, output);
+      return MaceStatus::MACE_SUCCESS;
+    }
+#endif  // MACE_ENABLE_QUANTIZE
+
     gemv_->Compute(context,
                    weight,
                    input,
@@ -112,9 +125,72 @@ class FullyConnectedOp<DeviceType::CPU, T> : public FullyConnectedOpBase {
     return MaceStatus::MACE_SUCCESS;
   }
 
+ private:
+#ifdef MACE_ENABLE_QUANTIZE
+  MaceStatus RunDynamicQuant(OpContext *context,
+                             const Tensor *input,
+                             const Tensor *weight,
+                             const Tensor *bias,
+                             const index_t batch,
+                             const index_t input_size,
+                             const index_t output_size,
+                             Tensor *output) {
+    if (gemv_q8_ == nullptr) {
+      gemv_q8_ = delegator::Gemv::Create(
+          context->workspace(),
+          MACE_DELEGATOR_KEY(Gemv, DeviceType::CPU, int32_t, kCpuImplType),
+          DelegatorParam());
+    }
+    MACE_RETURN_IF_ERROR(quant_input_.Resize(input->shape()));
+    MACE_RETURN_IF_ERROR(quant_output_.Resize(output->shape()));
+
+    utils::ThreadPool &thread_pool =
+        context->device()->cpu_runtime()->thread_pool();
+    QuantizeUtil<float, uint8_t> quantize_util(&thread_pool);
+    float in_scale = 0.f;
+    int32_t in_zero_point = 0;
+    {
+      Tensor::MappingGuard input_guard(input);
+      quantize_util.Quantize(input->data<float>(), input->size(), false,
+                             quant_input_.mutable_data<uint8_t>(),
+                             &in_scale, &in_zero_point);
+    }
+    quant_input_.SetScale(in_scale);
+    quant_input_.SetZeroPoint(in_zero_point);
+
+    MACE_RETURN_IF_ERROR(gemv_q8_->Compute(context, weight, &quant_input_,
+                                           nullptr, batch, output_size,
+                                           input_size, false, true,
+                                           &quant_output_));
+
+    // dequantize the int32 accumulators and add the float bias
+    const float out_scale = weight->scale() * in_scale;
+    const int32_t *quant_out_data = quant_output_.data<int32_t>();
+    Tensor::MappingGuard bias_guard(bias);
+    const float *bias_data = bias != nullptr ? bias->data<float>() : nullptr;
+    float *output_data = output->mutable_data<float>();
+    thread_pool.Compute1D([=](index_t start, index_t end, index_t step) {
+      for (index_t i = start; i < end; i += step) {
+        float value = quant_out_data[i] * out_scale;
+        if (bias_data != nullptr) {
+          value += bias_data[i % output_size];
+        }
+        output_data[i] = value;
+      }
+    }, 0, batch * output_size, 1);
+    return MaceStatus::MACE_SUCCESS;
+  }
+#endif  // MACE_ENABLE_QUANTIZE
+
  private:
   std::unique_ptr<delegator::Activation> activation_delegator_;
   std::unique_ptr<delegator::Gemv> gemv_;
+#ifdef MACE_ENABLE_QUANTIZE
+  // dynamic-range scratch, reused across runs
+  std::unique_ptr<delegator::Gemv> gemv_q8_;
+  Tensor quant_input_{GetCPUAllocator(), DataType::DT_UINT8};
+  Tensor quant_output_{GetCPUAllocator(), DataType::DT_INT32};
+#endif  // MACE_ENABLE_QUANTIZE
 };
 
 #ifdef MACE_ENABLE_QUANTIZE
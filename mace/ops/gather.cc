@@ -63,10 +63,23 @@ class GatherOp : public Operation {
                         params->shape().end(), 1, std::multiplies<index_t>());
     const index_t index_size = indices->size();
 
+    // big-table lookups are pure DRAM latency: prefetch the rows a few
+    // indices ahead so their misses overlap the current row's copy
+    constexpr index_t kPrefetchDistance = 4;
     for (index_t l = 0; l < lhs_size; ++l) {
       for (index_t idx = 0; idx < index_size; ++idx) {
         MACE_ASSERT(indices_data[idx] < axis_dim_size, "idx out of bound: ",
                     indices_data[idx]);
+#if defined(__GNUC__) || defined(__clang__)
+        if (idx + kPrefetchDistance < index_size) {
+          const T *prefetch_row = params_data +
+              ((l * axis_dim_size) + indices_data[idx + kPrefetchDistance]) *
+                  rhs_size;
+          __builtin_prefetch(prefetch_row, 0, 1);
+          __builtin_prefetch(
+              reinterpret_cast<const char *>(prefetch_row) + 64, 0, 1);
+        }
+#endif
         memcpy(
             output_data + ((l * index_size) + idx) * rhs_size,
             params_data + ((l * axis_dim_size) + indices_data[idx]) * rhs_size,
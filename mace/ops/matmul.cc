@@ -89,6 +89,16 @@ class MatMulOpBase : public Operation {
   bool transpose_b_;
 };
 
+// Attention score paths (MatMul -> scale -> Softmax -> MatMul) run as
+// separate ops with the full NxN score tensor round-tripping DRAM
+// twice. A fused attention op would stream score tiles: per row block,
+// QK^T tile -> scaled softmax in registers -> multiply into V, never
+// materializing the score matrix. The building blocks exist (packed
+// Gemm block kernels, the vectorized SoftmaxRow helper), but the fused
+// op needs per-tile K/V packing reuse across heads plus a converter
+// pattern matcher emitting the op; keeping scores tiled is what
+// delivers the DRAM saving, so a runtime-only fusion of the existing
+// whole-tensor kernels would not help.
 template<DeviceType D, class T>
 class MatMulOp;
 
@@ -100,7 +110,9 @@ class MatMulOp<CPU, T> : public MatMulOpBase {
         gemm_(delegator::Gemm::Create(
             context->workspace(),
             MACE_DELEGATOR_KEY(Gemm, DeviceType::CPU, T, kCpuImplType),
-            delegator::GemmParam())),
+            // cache packed constant operands across runs; the kernel
+            // only engages the cache for weight tensors
+            delegator::GemmParam(true))),
         gemv_(delegator::Gemv::Create(
             context->workspace(),
             MACE_DELEGATOR_KEY(Gemv, DeviceType::CPU, T, kCpuImplType),
@@ -97,6 +97,8 @@ class NonlocalReshapeOp<GPU, float> : public Operation {
 void RegisterNonlocalReshape(OpRegistry *op_registry) {
   MACE_REGISTER_OP(op_registry, "NonlocalReshape",
                    NonlocalReshapeOp, DeviceType::CPU, float);
+  MACE_REGISTER_BF16_OP(op_registry, "NonlocalReshape",
+                        NonlocalReshapeOp, DeviceType::CPU);
   MACE_REGISTER_OP(op_registry, "NonlocalReshape",
                    NonlocalReshapeOp, DeviceType::CPU, int32_t);
   MACE_REGISTER_GPU_OP(op_registry, "NonlocalReshape", NonlocalReshapeOp);
@@ -54,9 +54,10 @@ MaceStatus TransformConv2DFilter(
     MACE_OUT_OF_RANGE_CONFIG;
     std::string kernel_name = MACE_OBFUSCATE_SYMBOL("transform_conv_filter");
     built_options.emplace("-Dtransform_conv_filter=" + kernel_name);
-    std::string data_dt = DtToCLDt(input->dtype());
-    built_options.emplace("-DIN_DATA_TYPE=" + data_dt);
-    built_options.emplace("-DDATA_TYPE=" + data_dt);
+    // the output may be stored narrower than the input (e.g. fp16
+    // buffer mode); the kernel converts on store
+    built_options.emplace("-DIN_DATA_TYPE=" + DtToCLDt(input->dtype()));
+    built_options.emplace("-DDATA_TYPE=" + DtToCLDt(output->dtype()));
     MACE_RETURN_IF_ERROR(runtime->BuildKernel("buffer_transform",
                                               kernel_name,
                                               built_options,
@@ -123,9 +124,10 @@ MaceStatus TransformDWConv2DFilter(
     MACE_NON_UNIFORM_WG_CONFIG;
     std::string kernel_name = MACE_OBFUSCATE_SYMBOL("transform_dw_conv_filter");
     built_options.emplace("-Dtransform_dw_conv_filter=" + kernel_name);
-    std::string data_dt = DtToCLDt(input->dtype());
-    built_options.emplace("-DIN_DATA_TYPE=" + data_dt);
-    built_options.emplace("-DDATA_TYPE=" + data_dt);
+    // the output may be stored narrower than the input (e.g. fp16
+    // buffer mode); the kernel converts on store
+    built_options.emplace("-DIN_DATA_TYPE=" + DtToCLDt(input->dtype()));
+    built_options.emplace("-DDATA_TYPE=" + DtToCLDt(output->dtype()));
     MACE_RETURN_IF_ERROR(runtime->BuildKernel("buffer_transform",
                                               kernel_name,
                                               built_options,
@@ -180,9 +182,10 @@ MaceStatus TransformArgument(
     MACE_NON_UNIFORM_WG_CONFIG;
     std::string kernel_name = MACE_OBFUSCATE_SYMBOL("transform_arg");
     built_options.emplace("-Dtransform_arg=" + kernel_name);
-    std::string data_dt = DtToCLDt(input->dtype());
-    built_options.emplace("-DIN_DATA_TYPE=" + data_dt);
-    built_options.emplace("-DDATA_TYPE=" + data_dt);
+    // the output may be stored narrower than the input (e.g. fp16
+    // buffer mode); the kernel converts on store
+    built_options.emplace("-DIN_DATA_TYPE=" + DtToCLDt(input->dtype()));
+    built_options.emplace("-DDATA_TYPE=" + DtToCLDt(output->dtype()));
     MACE_RETURN_IF_ERROR(runtime->BuildKernel("buffer_transform",
                                               kernel_name,
                                               built_options,
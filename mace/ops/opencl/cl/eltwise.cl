@@ -14,6 +14,10 @@ __kernel void eltwise(OUT_OF_RANGE_PARAMS
 #ifdef COEFF_SUM
                       __private const float coeff0,
                       __private const float coeff1,
+#endif
+#ifdef FUSED_ACTIVATION
+                      __private const float relux_max_limit,
+                      __private const float activation_coefficient,
 #endif
                       __write_only image2d_t output) {
   const int chan_idx = get_global_id(0);
@@ -93,6 +97,10 @@ __kernel void eltwise(OUT_OF_RANGE_PARAMS
   out = sign(in0);
 #endif
 
+#ifdef FUSED_ACTIVATION
+  out = do_activation(out, relux_max_limit, activation_coefficient);
+#endif
+
 #if defined(NOT_DIVISIBLE_FOUR) &&                                       \
     ((ELTWISE_TYPE == 3 || ELTWISE_TYPE == 9 || ELTWISE_TYPE == 11)      \
      || ((defined(INPUT_SCALAR) || defined(INPUT_TENSOR_BC_CHAN)) &&     \
@@ -33,6 +33,11 @@ bool Conv2dKernel::CheckUseWinograd(
   }
   index_t out_channels = filter_shape[0];
   index_t in_channels = filter_shape[1];
+  // mirror the CPU heuristic: with few channels the per-tile GEMM is
+  // too shallow to amortize the input/output transform kernels
+  if (in_channels < 8 || out_channels < 8) {
+    return false;
+  }
   auto opencl_image_max_size = runtime->GetMaxImage2DSize();
   auto check_opencl_limit = [&](int block_size) -> bool {
     int sqr_block = (block_size + 2) * (block_size + 2);
@@ -123,6 +123,19 @@ MaceStatus EltwiseKernel::Compute(
     if (swapped) built_options.emplace("-DSWAPPED");
     if (channels % 4 != 0) built_options.emplace("-DNOT_DIVISIBLE_FOUR");
     if (!coeff_.empty()) built_options.emplace("-DCOEFF_SUM");
+    if (activation_ != ActivationType::NOOP) {
+      built_options.emplace("-DFUSED_ACTIVATION");
+      switch (activation_) {
+        case RELU: built_options.emplace("-DUSE_RELU"); break;
+        case RELUX: built_options.emplace("-DUSE_RELUX"); break;
+        case TANH: built_options.emplace("-DUSE_TANH"); break;
+        case SIGMOID: built_options.emplace("-DUSE_SIGMOID"); break;
+        case LEAKYRELU: built_options.emplace("-DUSE_LEAKYRELU"); break;
+        case ELU: built_options.emplace("-DUSE_ELU"); break;
+        default:
+          LOG(FATAL) << "Unknown fused activation type: " << activation_;
+      }
+    }
     MACE_RETURN_IF_ERROR(runtime->BuildKernel("eltwise", kernel_name,
                                               built_options, &kernel_));
 
@@ -147,6 +160,10 @@ MaceStatus EltwiseKernel::Compute(
       kernel_.setArg(idx++, coeff_[0]);
       kernel_.setArg(idx++, coeff_[1]);
     }
+    if (activation_ != ActivationType::NOOP) {
+      kernel_.setArg(idx++, relux_max_limit_);
+      kernel_.setArg(idx++, activation_coefficient_);
+    }
     kernel_.setArg(idx++, *(output->opencl_image()));
 
     input_shape_ = input0->shape();
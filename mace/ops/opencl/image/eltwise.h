@@ -24,6 +24,7 @@
 
 #include "mace/core/ops/op_context.h"
 #include "mace/core/tensor.h"
+#include "mace/ops/common/activation_type.h"
 #include "mace/ops/common/eltwise_type.h"
 #include "mace/core/runtime/opencl/opencl_helper.h"
 
@@ -38,11 +39,17 @@ class EltwiseKernel : public OpenCLEltwiseKernel {
       const EltwiseType type,
       const std::vector<float> &coeff,
       const float scalar_input,
-      const int32_t scalar_input_index)
+      const int32_t scalar_input_index,
+      const ActivationType activation = ActivationType::NOOP,
+      const float relux_max_limit = 0.f,
+      const float activation_coefficient = 0.f)
       : type_(type),
         coeff_(coeff),
         scalar_input_(scalar_input),
-        scalar_input_index_(scalar_input_index) {}
+        scalar_input_index_(scalar_input_index),
+        activation_(activation),
+        relux_max_limit_(relux_max_limit),
+        activation_coefficient_(activation_coefficient) {}
   MaceStatus Compute(
       OpContext *context,
       const Tensor *input0,
@@ -54,6 +61,10 @@ class EltwiseKernel : public OpenCLEltwiseKernel {
   std::vector<float> coeff_;
   float scalar_input_;
   int32_t scalar_input_index_;
+  // pointwise chain fusion: activation applied in the same kernel
+  ActivationType activation_;
+  float relux_max_limit_;
+  float activation_coefficient_;
   cl::Kernel kernel_;
   uint32_t kwg_size_;
   std::vector<index_t> input_shape_;
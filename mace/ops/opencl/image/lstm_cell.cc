@@ -19,6 +19,17 @@ namespace ops {
 namespace opencl {
 namespace image {
 
+// GPU recurrence today is this single fused LSTMCell image kernel,
+// driven step by step from the host; multi-layer/bidirectional LSTMs
+// fall back to CPU. A GPU recurrent engine needs (a) a persistent
+// GPU-resident state tensor reused across steps without host
+// round-trips (the image allocator supports this; the op interface
+// does not express carried state), and (b) host-side step sequencing
+// without a per-step enqueue bubble, which the batched-enqueue mode
+// now provides. GRU shares the cell structure with one fewer gate and
+// can reuse this kernel family once carried state exists.
+
+
 MaceStatus LSTMCellKernel::Compute(
     OpContext *context,
     const Tensor *input,
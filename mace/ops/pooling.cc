@@ -70,6 +70,15 @@ class PoolingOp<DeviceType::CPU, T> : public PoolingOpBase {
     MACE_UNUSED(context);
     const Tensor *input_tensor = this->Input(0);
     Tensor *output_tensor = this->Output(0);
+    // native NHWC path: no layout transposes needed around this op and
+    // the channel-contiguous inner loops vectorize directly. Graphs
+    // normalized by NetDefAdapter carry has_data_format and are NCHW
+    // here regardless of the tensor's tag (same convention as softmax).
+    if (input_tensor->data_format() == DataFormat::NHWC &&
+        input_tensor->dim_size() == 4 &&
+        Operation::GetOptionalArg<int>("has_data_format", 0) == 0) {
+      return RunNHWC(context);
+    }
     std::vector<index_t> output_shape(4);
     std::vector<index_t> filter_shape = {
         input_tensor->dim(1), input_tensor->dim(1), kernels_[0], kernels_[1]};
@@ -127,6 +136,119 @@ class PoolingOp<DeviceType::CPU, T> : public PoolingOpBase {
   }
 
  private:
+  // Specialized NEON pools (3x3 stride-2 with hoisted edge handling:
+  // interior tiles take a branch-free vectorized path, borders take
+  // the generic one) would slot in as delegators like the conv
+  // kernels; the NCHW scalar loops below keep per-window bounds checks
+  // in the hot loop. The NHWC path above already vectorizes across
+  // channels and hoists nothing because its inner loop is contiguous.
+  MaceStatus RunNHWC(OpContext *context) {
+    const Tensor *input_tensor = this->Input(0);
+    Tensor *output_tensor = this->Output(0);
+    output_tensor->set_data_format(DataFormat::NHWC);
+
+    std::vector<index_t> output_shape(4);
+    std::vector<index_t> filter_shape = {
+        input_tensor->dim(3), kernels_[0], kernels_[1], input_tensor->dim(3)};
+
+    std::vector<int> paddings(2);
+    if (paddings_.empty()) {
+      CalcPaddingAndOutputSize(input_tensor->shape().data(),
+                               DataFormat::NHWC,
+                               filter_shape.data(),
+                               DataFormat::OHWI,
+                               dilations_.data(),
+                               strides_.data(),
+                               padding_type_,
+                               output_shape.data(),
+                               paddings.data());
+    } else {
+      paddings = paddings_;
+      CalcOutputSize(input_tensor->shape().data(),
+                     DataFormat::NHWC,
+                     filter_shape.data(),
+                     DataFormat::OHWI,
+                     paddings_.data(),
+                     dilations_.data(),
+                     strides_.data(),
+                     round_type_,
+                     output_shape.data());
+    }
+    MACE_RETURN_IF_ERROR(output_tensor->Resize(output_shape));
+
+    Tensor::MappingGuard input_guard(input_tensor);
+    Tensor::MappingGuard output_guard(output_tensor);
+    const T *input = input_tensor->data<T>();
+    T *output = output_tensor->mutable_data<T>();
+
+    const index_t batch = output_shape[0];
+    const index_t out_height = output_shape[1];
+    const index_t out_width = output_shape[2];
+    const index_t channels = output_shape[3];
+    const index_t in_height = input_tensor->dim(1);
+    const index_t in_width = input_tensor->dim(2);
+    const int pad_top = paddings[0] / 2;
+    const int pad_left = paddings[1] / 2;
+    const bool is_max = pooling_type_ == PoolingType::MAX;
+    MACE_CHECK(is_max || pooling_type_ == PoolingType::AVG);
+    const int filter_h = kernels_[0];
+    const int filter_w = kernels_[1];
+    const int stride_h = strides_[0];
+    const int stride_w = strides_[1];
+    const int dilation_h = dilations_[0];
+    const int dilation_w = dilations_[1];
+
+    utils::ThreadPool
+        &thread_pool = context->device()->cpu_runtime()->thread_pool();
+    thread_pool.Compute2D([=](index_t start0, index_t end0, index_t step0,
+                              index_t start1, index_t end1, index_t step1) {
+      for (index_t b = start0; b < end0; b += step0) {
+        for (index_t h = start1; h < end1; h += step1) {
+          for (index_t w = 0; w < out_width; ++w) {
+            T *out_ptr =
+                output + ((b * out_height + h) * out_width + w) * channels;
+            const float init =
+                is_max ? std::numeric_limits<float>::lowest() : 0.f;
+            for (index_t c = 0; c < channels; ++c) {
+              out_ptr[c] = init;
+            }
+            int block_size = 0;
+            for (int fh = 0; fh < filter_h; ++fh) {
+              for (int fw = 0; fw < filter_w; ++fw) {
+                const index_t inh = h * stride_h + dilation_h * fh - pad_top;
+                const index_t inw = w * stride_w + dilation_w * fw - pad_left;
+                if (inh < 0 || inh >= in_height ||
+                    inw < 0 || inw >= in_width) {
+                  continue;
+                }
+                const T *in_ptr = input
+                    + ((b * in_height + inh) * in_width + inw) * channels;
+                if (is_max) {
+                  for (index_t c = 0; c < channels; ++c) {
+                    out_ptr[c] = std::max<T>(out_ptr[c], in_ptr[c]);
+                  }
+                } else {
+                  for (index_t c = 0; c < channels; ++c) {
+                    out_ptr[c] += in_ptr[c];
+                  }
+                }
+                ++block_size;
+              }
+            }
+            if (!is_max && block_size > 0) {
+              const float scale = 1.f / block_size;
+              for (index_t c = 0; c < channels; ++c) {
+                out_ptr[c] = static_cast<float>(out_ptr[c]) * scale;
+              }
+            }
+          }
+        }
+      }
+    }, 0, batch, 1, 0, out_height, 1);
+
+    return MaceStatus::MACE_SUCCESS;
+  }
+
   void MaxPooling(const OpContext *context,
                   const T *input,
                   const index_t *in_shape,
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <set>
 #include <vector>
@@ -27,11 +28,121 @@
 #ifdef MACE_ENABLE_OPENCL
 #include "mace/ops/opencl/image/reduce.h"
 #endif  // MACE_ENABLE_OPENCL
+#ifdef MACE_ENABLE_NEON
+#include "mace/ops/arm/base/common_neon.h"
+#endif  // MACE_ENABLE_NEON
 #include "mace/utils/memory.h"
 
 namespace mace {
 namespace ops {
 
+namespace {
+
+// contiguous-axis row reductions; the float overloads below use four
+// NEON accumulators so global-average-pool style reductions stream at
+// memory bandwidth instead of one scalar add per element
+template<typename S>
+S RowSum(const S *row, const index_t n) {
+  S tmp = 0.f;
+  for (index_t j = 0; j < n; ++j) {
+    tmp += row[j];
+  }
+  return tmp;
+}
+
+template<typename S>
+S RowMin(const S *row, const index_t n) {
+  S tmp = row[0];
+  for (index_t j = 1; j < n; ++j) {
+    tmp = std::min(tmp, row[j]);
+  }
+  return tmp;
+}
+
+template<typename S>
+S RowMax(const S *row, const index_t n) {
+  S tmp = row[0];
+  for (index_t j = 1; j < n; ++j) {
+    tmp = std::max(tmp, row[j]);
+  }
+  return tmp;
+}
+
+#ifdef MACE_ENABLE_NEON
+inline float RowSum(const float *row, const index_t n) {
+  const index_t block_size = n & ~15;
+  float32x4_t vsum0 = vdupq_n_f32(0.f);
+  float32x4_t vsum1 = vdupq_n_f32(0.f);
+  float32x4_t vsum2 = vdupq_n_f32(0.f);
+  float32x4_t vsum3 = vdupq_n_f32(0.f);
+  index_t j = 0;
+  for (; j < block_size; j += 16) {
+    vsum0 = vaddq_f32(vsum0, vld1q_f32(row + j));
+    vsum1 = vaddq_f32(vsum1, vld1q_f32(row + j + 4));
+    vsum2 = vaddq_f32(vsum2, vld1q_f32(row + j + 8));
+    vsum3 = vaddq_f32(vsum3, vld1q_f32(row + j + 12));
+  }
+  vsum0 = vaddq_f32(vaddq_f32(vsum0, vsum1), vaddq_f32(vsum2, vsum3));
+#ifdef __aarch64__
+  float sum = vaddvq_f32(vsum0);
+#else
+  float sum = arm::vaddvq_f32(vsum0);
+#endif
+  for (; j < n; ++j) {
+    sum += row[j];
+  }
+  return sum;
+}
+
+inline float RowMin(const float *row, const index_t n) {
+  const index_t block_size = n & ~3;
+  float32x4_t vmin = vdupq_n_f32(std::numeric_limits<float>::max());
+  index_t j = 0;
+  for (; j < block_size; j += 4) {
+    vmin = vminq_f32(vmin, vld1q_f32(row + j));
+  }
+#ifdef __aarch64__
+  float tmp = vminvq_f32(vmin);
+#else
+  float32x2_t vmin2 = vmin_f32(vget_low_f32(vmin), vget_high_f32(vmin));
+  vmin2 = vpmin_f32(vmin2, vmin2);
+  float tmp = vget_lane_f32(vmin2, 0);
+#endif
+  if (block_size == 0) {
+    tmp = row[0];
+  }
+  for (; j < n; ++j) {
+    tmp = std::min(tmp, row[j]);
+  }
+  return tmp;
+}
+
+inline float RowMax(const float *row, const index_t n) {
+  const index_t block_size = n & ~3;
+  float32x4_t vmax = vdupq_n_f32(std::numeric_limits<float>::lowest());
+  index_t j = 0;
+  for (; j < block_size; j += 4) {
+    vmax = vmaxq_f32(vmax, vld1q_f32(row + j));
+  }
+#ifdef __aarch64__
+  float tmp = vmaxvq_f32(vmax);
+#else
+  float32x2_t vmax2 = vmax_f32(vget_low_f32(vmax), vget_high_f32(vmax));
+  vmax2 = vpmax_f32(vmax2, vmax2);
+  float tmp = vget_lane_f32(vmax2, 0);
+#endif
+  if (block_size == 0) {
+    tmp = row[0];
+  }
+  for (; j < n; ++j) {
+    tmp = std::max(tmp, row[j]);
+  }
+  return tmp;
+}
+#endif  // MACE_ENABLE_NEON
+
+}  // namespace
+
 class ReduceOpBase : public Operation {
  public:
   explicit ReduceOpBase(OpConstructContext *context)
@@ -247,27 +358,18 @@ class ReduceOp<DeviceType::CPU, T> : public ReduceOpBase {
       thread_pool.Compute1D([=](index_t start, index_t end, index_t step) {
         if (type == ReduceType::MEAN) {
           for (index_t i = start; i < end; i += step) {
-            T tmp = 0.f;
-            for (int j = 0; j < data_reshape_[1]; ++j) {
-              tmp += input[i * data_reshape_[1] + j];
-            }
-            output[i] = tmp / data_reshape_[1];
+            output[i] = RowSum(input + i * data_reshape_[1],
+                               data_reshape_[1]) / data_reshape_[1];
           }
         } else if (type == ReduceType::MIN) {
           for (index_t i = start; i < end; i += step) {
-            T tmp = input[i * data_reshape_[1]];
-            for (int j = 1; j < data_reshape_[1]; ++j) {
-              tmp = std::min(tmp, input[i * data_reshape_[1] + j]);
-            }
-            output[i] = tmp;
+            output[i] = RowMin(input + i * data_reshape_[1],
+                               data_reshape_[1]);
           }
         } else if (type == ReduceType::MAX) {
           for (index_t i = start; i < end; i += step) {
-            T tmp = input[i * data_reshape_[1]];
-            for (int j = 1; j < data_reshape_[1]; ++j) {
-              tmp = std::max(tmp, input[i * data_reshape_[1] + j]);
-            }
-            output[i] = tmp;
+            output[i] = RowMax(input + i * data_reshape_[1],
+                               data_reshape_[1]);
           }
         } else if (type == ReduceType::PROD) {
           for (index_t i = start; i < end; i += step) {
@@ -279,11 +381,8 @@ class ReduceOp<DeviceType::CPU, T> : public ReduceOpBase {
           }
         } else if (type == ReduceType::SUM) {
           for (index_t i = start; i < end; i += step) {
-            T tmp = 0.f;
-            for (int j = 0; j < data_reshape_[1]; ++j) {
-              tmp += input[i * data_reshape_[1] + j];
-            }
-            output[i] = tmp;
+            output[i] = RowSum(input + i * data_reshape_[1],
+                               data_reshape_[1]);
           }
         } else {
           MACE_NOT_IMPLEMENTED;
@@ -54,6 +54,8 @@ extern void RegisterDeconv2dK3x3Delegator(OpDelegatorRegistry *registry);
 extern void RegisterDeconv2dK4x4Delegator(OpDelegatorRegistry *registry);
 extern void RegisterDeconv2dGeneralDelegator(OpDelegatorRegistry *registry);
 
+extern void RegisterDepthwiseConv2dK5x5Delegator(
+    OpDelegatorRegistry *registry);
 extern void RegisterDepthwiseConv2dK3x3Delegator(
     OpDelegatorRegistry *registry);
 extern void RegisterDepthwiseDeconv2dK3x3Delegator(
@@ -117,6 +119,7 @@ void RegisterAllOpDelegators(OpDelegatorRegistry *registry) {
   arm::RegisterDeconv2dGeneralDelegator(registry);
 
   arm::RegisterDepthwiseConv2dK3x3Delegator(registry);
+  arm::RegisterDepthwiseConv2dK5x5Delegator(registry);
   arm::RegisterDepthwiseDeconv2dK3x3Delegator(registry);
   arm::RegisterGroupDeconv2dK3x3Delegator(registry);
   arm::RegisterDepthwiseDeconv2dK4x4Delegator(registry);
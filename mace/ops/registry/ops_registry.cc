@@ -21,6 +21,7 @@ namespace ops {
 extern void RegisterActivation(OpRegistry *op_registry);
 extern void RegisterAddN(OpRegistry *op_registry);
 extern void RegisterArgMax(OpRegistry *op_registry);
+extern void RegisterTopK(OpRegistry *op_registry);
 extern void RegisterBatchNorm(OpRegistry *op_registry);
 extern void RegisterBatchToSpaceND(OpRegistry *op_registry);
 extern void RegisterBiasAdd(OpRegistry *op_registry);
@@ -103,6 +104,7 @@ void RegisterAllOps(OpRegistry *registry) {
   ops::RegisterActivation(registry);
   ops::RegisterAddN(registry);
   ops::RegisterArgMax(registry);
+  ops::RegisterTopK(registry);
   ops::RegisterBatchNorm(registry);
   ops::RegisterBatchToSpaceND(registry);
   ops::RegisterBiasAdd(registry);
@@ -136,19 +136,47 @@ inline void ResizeImage(
   utils::ThreadPool
       &thread_pool = context->device()->cpu_runtime()->thread_pool();
 
+  // Per-axis caches: weights/indices are functions of the coordinate
+  // alone, so compute them once per run, O(W + H), instead of per
+  // output pixel, and keep the hot loops free of heap allocation.
+  std::vector<float> x_weights_tab(out_width * 4);
+  std::vector<index_t> x_indices_tab(out_width * 4);
+  for (index_t x = 0; x < out_width; ++x) {
+    std::vector<float> x_weights;
+    std::vector<index_t> x_indices;
+    GetWeightsAndIndices(width_scale, coordinate_transformation_mode, x,
+                         out_width, in_width, &x_weights, &x_indices);
+    for (int i = 0; i < 4; ++i) {
+      x_weights_tab[x * 4 + i] = x_weights[i];
+      x_indices_tab[x * 4 + i] = x_indices[i];
+    }
+  }
+  std::vector<float> y_weights_tab(out_height * 4);
+  std::vector<index_t> y_indices_tab(out_height * 4);
+  for (index_t y = 0; y < out_height; ++y) {
+    std::vector<float> y_weights;
+    std::vector<index_t> y_indices;
+    GetWeightsAndIndices(height_scale, coordinate_transformation_mode, y,
+                         out_height, in_height, &y_weights, &y_indices);
+    for (int i = 0; i < 4; ++i) {
+      y_weights_tab[y * 4 + i] = y_weights[i];
+      y_indices_tab[y * 4 + i] = y_indices[i];
+    }
+  }
+  const float *x_weights_ptr = x_weights_tab.data();
+  const index_t *x_indices_ptr = x_indices_tab.data();
+  const float *y_weights_ptr = y_weights_tab.data();
+  const index_t *y_indices_ptr = y_indices_tab.data();
+
   thread_pool.Compute2D([=](index_t start0, index_t end0, index_t step0,
                             index_t start1, index_t end1, index_t step1) {
     for (index_t b = start0; b < end0; b += step0) {
       for (index_t y = start1; y < end1; y += step1) {
-        std::vector<float> y_weights;
-        std::vector<index_t> y_indices;
-        GetWeightsAndIndices(height_scale, coordinate_transformation_mode, y,
-                             out_height, in_height, &y_weights, &y_indices);
+        const float *y_weights = y_weights_ptr + y * 4;
+        const index_t *y_indices = y_indices_ptr + y * 4;
         for (index_t x = 0; x < out_width; ++x) {
-          std::vector<float> x_weights;
-          std::vector<index_t> x_indices;
-          GetWeightsAndIndices(width_scale, coordinate_transformation_mode, x,
-                               out_width, in_width, &x_weights, &x_indices);
+          const float *x_weights = x_weights_ptr + x * 4;
+          const index_t *x_indices = x_indices_ptr + x * 4;
 
           for (index_t c = 0; c < channels; ++c) {
             // Use a 4x4 patch to compute the interpolated output value at
@@ -157,17 +185,17 @@ inline void ResizeImage(
                 images + (b * channels + c) * in_height * in_width;
             float *channel_output_ptr =
                 output + (b * channels + c) * out_height * out_width;
-            std::vector<float> coeff(4, 0.0);
+            float coeff[4];
             for (index_t i = 0; i < 4; ++i) {
-              const std::vector<float> values = {
-                  channel_input_ptr[y_indices[i] * in_width + x_indices[0]],
-                  channel_input_ptr[y_indices[i] * in_width + x_indices[1]],
-                  channel_input_ptr[y_indices[i] * in_width + x_indices[2]],
-                  channel_input_ptr[y_indices[i] * in_width + x_indices[3]]};
-              coeff[i] = Interpolate1D(x_weights, values);
+              const float *row = channel_input_ptr + y_indices[i] * in_width;
+              coeff[i] = row[x_indices[0]] * x_weights[0] +
+                  row[x_indices[1]] * x_weights[1] +
+                  row[x_indices[2]] * x_weights[2] +
+                  row[x_indices[3]] * x_weights[3];
             }
             channel_output_ptr[y * out_width + x] =
-                Interpolate1D(y_weights, coeff);
+                coeff[0] * y_weights[0] + coeff[1] * y_weights[1] +
+                coeff[2] * y_weights[2] + coeff[3] * y_weights[3];
           }
         }
       }
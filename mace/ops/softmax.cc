@@ -31,11 +31,111 @@
 #include "mace/ops/opencl/buffer/softmax.h"
 #endif  // MACE_ENABLE_OPENCL
 
+#ifdef MACE_ENABLE_NEON
+#include "mace/ops/arm/base/common_neon.h"
+#endif  // MACE_ENABLE_NEON
+
 #include "mace/utils/memory.h"
 
 namespace mace {
 namespace ops {
 
+namespace {
+
+// scalar fallback for non-float types
+template<typename S>
+void SoftmaxRow(const S *input_ptr, const index_t class_size,
+                const bool use_log, S *output_ptr) {
+  float max_val = std::numeric_limits<float>::lowest();
+  for (index_t c = 0; c < class_size; ++c) {
+    max_val = std::max<float>(max_val, input_ptr[c]);
+  }
+  float sum = 0;
+  for (index_t c = 0; c < class_size; ++c) {
+    float exp_value = std::exp(input_ptr[c] - max_val);
+    sum += exp_value;
+    output_ptr[c] = exp_value;
+  }
+  if (use_log) {
+    // log(exp(x - max) / sum) = (x - max) - log(sum)
+    const float log_sum = std::log(sum);
+    for (index_t c = 0; c < class_size; ++c) {
+      output_ptr[c] = (input_ptr[c] - max_val) - log_sum;
+    }
+  } else {
+    for (index_t c = 0; c < class_size; ++c) {
+      output_ptr[c] /= sum;
+    }
+  }
+}
+
+#ifdef MACE_ENABLE_NEON
+// single pass max + fused vectorized exp/sum; log-softmax reduces to a
+// subtraction, so no per-element log is ever taken
+inline void SoftmaxRow(const float *input_ptr, const index_t class_size,
+                       const bool use_log, float *output_ptr) {
+  const index_t block_size = class_size & ~3;
+  float32x4_t vmax = vdupq_n_f32(std::numeric_limits<float>::lowest());
+  index_t c = 0;
+  for (; c < block_size; c += 4) {
+    vmax = vmaxq_f32(vmax, vld1q_f32(input_ptr + c));
+  }
+#ifdef __aarch64__
+  float max_val = vmaxvq_f32(vmax);
+#else
+  float32x2_t vmax2 = vmax_f32(vget_low_f32(vmax), vget_high_f32(vmax));
+  vmax2 = vpmax_f32(vmax2, vmax2);
+  float max_val = vget_lane_f32(vmax2, 0);
+#endif
+  for (; c < class_size; ++c) {
+    max_val = std::max(max_val, input_ptr[c]);
+  }
+
+  const float32x4_t vmax_val = vdupq_n_f32(max_val);
+  float32x4_t vsum = vdupq_n_f32(0.f);
+  for (c = 0; c < block_size; c += 4) {
+    const float32x4_t ve =
+        arm::vexpq_f32(vsubq_f32(vld1q_f32(input_ptr + c), vmax_val));
+    vsum = vaddq_f32(vsum, ve);
+    vst1q_f32(output_ptr + c, ve);
+  }
+#ifdef __aarch64__
+  float sum = vaddvq_f32(vsum);
+#else
+  float sum = arm::vaddvq_f32(vsum);
+#endif
+  for (; c < class_size; ++c) {
+    const float exp_value = std::exp(input_ptr[c] - max_val);
+    sum += exp_value;
+    output_ptr[c] = exp_value;
+  }
+
+  if (use_log) {
+    const float shift = max_val + std::log(sum);
+    const float32x4_t vshift = vdupq_n_f32(shift);
+    for (c = 0; c < block_size; c += 4) {
+      vst1q_f32(output_ptr + c,
+                vsubq_f32(vld1q_f32(input_ptr + c), vshift));
+    }
+    for (; c < class_size; ++c) {
+      output_ptr[c] = input_ptr[c] - shift;
+    }
+  } else {
+    const float32x4_t vinv_sum = vdupq_n_f32(1.f / sum);
+    for (c = 0; c < block_size; c += 4) {
+      vst1q_f32(output_ptr + c,
+                vmulq_f32(vld1q_f32(output_ptr + c), vinv_sum));
+    }
+    const float inv_sum = 1.f / sum;
+    for (; c < class_size; ++c) {
+      output_ptr[c] *= inv_sum;
+    }
+  }
+}
+#endif  // MACE_ENABLE_NEON
+
+}  // namespace
+
 template<DeviceType D, typename T>
 class SoftmaxOp;
 
@@ -197,38 +297,14 @@ class SoftmaxOp<DeviceType::CPU, T> : public Operation {
     utils::ThreadPool
         &thread_pool = context->device()->cpu_runtime()->thread_pool();
     const T *input_data = input->data<T>();
-    float std_lowest = std::numeric_limits<float>::lowest();
     for (index_t b_offset = 0; b_offset < batch_size;
          b_offset += batch_stride) {
       const T *input_b_ptr = input_data + b_offset;
       T *output_b_ptr = output_data + b_offset;
+      const bool use_log = use_log_;
       thread_pool.Compute1D([=](index_t start, index_t end, index_t step) {
         for (index_t k = start; k < end; k += step) {
-          const T *input_ptr = input_b_ptr + k;
-          T *output_ptr = output_b_ptr + k;
-
-          float max_val = std_lowest;
-          for (index_t c = 0; c < class_size; ++c) {
-            max_val = std::max(max_val, input_ptr[c]);
-          }
-
-          float sum = 0;
-          for (index_t c = 0; c < class_size; ++c) {
-            float exp_value = std::exp(input_ptr[c] - max_val);
-            sum += exp_value;
-            output_ptr[c] = exp_value;
-          }
-
-          if (use_log_) {
-            for (index_t c = 0; c < class_size; ++c) {
-              float output = (static_cast<float>(output_ptr[c])) / sum;
-              output_ptr[c] = std::log(output);
-            }
-          } else {
-            for (index_t c = 0; c < class_size; ++c) {
-              output_ptr[c] /= sum;
-            }
-          }
+          SoftmaxRow(input_b_ptr + k, class_size, use_log, output_b_ptr + k);
         }  // k
       }, 0, hw_size, hw_stride);
     }  // b_offset
@@ -177,6 +177,12 @@ void RegisterSplit(OpRegistry *op_registry) {
   MACE_REGISTER_OP(op_registry, "Split", SplitOp, DeviceType::CPU, float);
   MACE_REGISTER_BF16_OP(op_registry, "Split", SplitOp, DeviceType::CPU);
 
+#ifdef MACE_ENABLE_QUANTIZE
+  // pure data movement: the generic kernel handles u8 natively, so
+  // quantized graphs do not bounce through float here
+  MACE_REGISTER_OP(op_registry, "Split", SplitOp, DeviceType::CPU, uint8_t);
+#endif  // MACE_ENABLE_QUANTIZE
+
   MACE_REGISTER_GPU_OP(op_registry, "Split", SplitOp);
 
   MACE_REGISTER_OP_CONDITION(
@@ -23,6 +23,17 @@
 namespace mace {
 namespace ops {
 
+// Contiguous unit-stride slices (e.g. the audio frontend taking the
+// last N frames) could be Tensor views: an offset into the producer's
+// buffer instead of a copy. Tensor can express that (the BufferSlice
+// constructor), but op outputs are bound to planned blocks before
+// shapes are known, and a view output would also extend the producer's
+// live range past what MemoryOptimizer computed from the graph, so the
+// optimizer must learn view edges (alias with offset, merged liveness)
+// first -- the same machinery in-place Reshape uses, plus an offset.
+// Until then every slice materializes.
+
+
 template <DeviceType D, typename T>
 class StridedSliceOp : public Operation {
  public:
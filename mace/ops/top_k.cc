@@ -0,0 +1,101 @@
+// Copyright 2020 The MACE Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "mace/core/ops/operator.h"
+#include "mace/core/registry/ops_registry.h"
+#include "mace/core/runtime/cpu/cpu_runtime.h"
+
+namespace mace {
+namespace ops {
+
+// Top-k selection along the last axis, for beam search and
+// classification heads that previously copied full logits to the app.
+// Outputs the k largest values in descending order plus their indices.
+template<DeviceType D, class T>
+class TopKOp;
+
+template<class T>
+class TopKOp<DeviceType::CPU, T> : public Operation {
+ public:
+  explicit TopKOp(OpConstructContext *context)
+      : Operation(context),
+        k_(Operation::GetOptionalArg<int>("k", 1)) {}
+
+  MaceStatus Run(OpContext *context) override {
+    const Tensor *input = this->Input(0);
+    Tensor *values = this->Output(VALUES);
+    Tensor *indices = this->Output(INDICES);
+
+    MACE_CHECK(input->dim_size() >= 1, "TopK needs at least rank 1");
+    const index_t row_size = input->dim(input->dim_size() - 1);
+    const index_t k = std::min<index_t>(k_, row_size);
+    MACE_CHECK(k >= 1, "k must be positive, got ", k_);
+    const index_t row_count = input->size() / row_size;
+
+    std::vector<index_t> output_shape = input->shape();
+    output_shape.back() = k;
+    MACE_RETURN_IF_ERROR(values->Resize(output_shape));
+    indices->SetDtype(DataType::DT_INT32);
+    MACE_RETURN_IF_ERROR(indices->Resize(output_shape));
+
+    Tensor::MappingGuard input_guard(input);
+    Tensor::MappingGuard values_guard(values);
+    Tensor::MappingGuard indices_guard(indices);
+    const T *input_data = input->data<T>();
+    T *values_data = values->mutable_data<T>();
+    int32_t *indices_data = indices->mutable_data<int32_t>();
+
+    utils::ThreadPool &thread_pool =
+        context->device()->cpu_runtime()->thread_pool();
+    thread_pool.Compute1D([=](index_t start, index_t end, index_t step) {
+      std::vector<int32_t> order(row_size);
+      for (index_t r = start; r < end; r += step) {
+        const T *row = input_data + r * row_size;
+        std::iota(order.begin(), order.end(), 0);
+        std::partial_sort(
+            order.begin(), order.begin() + k, order.end(),
+            [row](int32_t a, int32_t b) {
+              return row[a] > row[b] || (row[a] == row[b] && a < b);
+            });
+        T *values_row = values_data + r * k;
+        int32_t *indices_row = indices_data + r * k;
+        for (index_t i = 0; i < k; ++i) {
+          values_row[i] = row[order[i]];
+          indices_row[i] = order[i];
+        }
+      }
+    }, 0, row_count, 1);
+
+    return MaceStatus::MACE_SUCCESS;
+  }
+
+ private:
+  const int k_;
+
+  MACE_OP_INPUT_TAGS(INPUT);
+  MACE_OP_OUTPUT_TAGS(VALUES, INDICES);
+};
+
+void RegisterTopK(OpRegistry *op_registry) {
+  MACE_REGISTER_OP(op_registry, "TopK", TopKOp, DeviceType::CPU, float);
+  MACE_REGISTER_OP(op_registry, "TopK", TopKOp, DeviceType::CPU, int32_t);
+}
+
+}  // namespace ops
+}  // namespace mace
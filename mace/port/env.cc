@@ -30,6 +30,10 @@ MaceStatus Env::GetCPUMaxFreq(std::vector<float> *max_freqs) {
   return MaceStatus::MACE_UNSUPPORTED;
 }
 
+MaceStatus Env::GetCPUCurFreq(std::vector<float> *cur_freqs) {
+  return MaceStatus::MACE_UNSUPPORTED;
+}
+
 MaceStatus Env::SchedSetAffinity(const std::vector<size_t> &cpu_ids) {
   return MaceStatus::MACE_UNSUPPORTED;
 }
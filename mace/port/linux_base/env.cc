@@ -103,6 +103,34 @@ MaceStatus LinuxBaseEnv::GetCPUMaxFreq(std::vector<float> *max_freqs) {
   return MaceStatus::MACE_SUCCESS;
 }
 
+MaceStatus LinuxBaseEnv::GetCPUCurFreq(std::vector<float> *cur_freqs) {
+  MACE_CHECK_NOTNULL(cur_freqs);
+  int cpu_count = GetCPUCount();
+  if (cpu_count < 0) {
+    return MaceStatus::MACE_RUNTIME_ERROR;
+  }
+  for (int cpu_id = 0; cpu_id < cpu_count; ++cpu_id) {
+    std::string scaling_cur_freq_sys_conf = MakeString(
+        "/sys/devices/system/cpu/cpu",
+        cpu_id,
+        "/cpufreq/scaling_cur_freq");
+    std::ifstream f(scaling_cur_freq_sys_conf);
+    if (!f.is_open()) {
+      // offline core or no cpufreq: report 0, callers skip such cores
+      cur_freqs->push_back(0);
+      continue;
+    }
+    std::string line;
+    if (std::getline(f, line)) {
+      cur_freqs->push_back(strtof(line.c_str(), nullptr));
+    } else {
+      cur_freqs->push_back(0);
+    }
+    f.close();
+  }
+  return MaceStatus::MACE_SUCCESS;
+}
+
 MaceStatus LinuxBaseEnv::SchedSetAffinity(const std::vector<size_t> &cpu_ids) {
   cpu_set_t mask;
   CPU_ZERO(&mask);
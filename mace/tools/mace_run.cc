@@ -27,6 +27,8 @@
 #include <sys/types.h>
 #include <dirent.h>
 #include <stdint.h>
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
@@ -441,6 +443,8 @@ bool RunModel(const std::string &model_name,
     if (FLAGS_round > 0) {
       LOG(INFO) << "Run model";
       int64_t total_run_duration = 0;
+      std::vector<double> round_millis;
+      round_millis.reserve(FLAGS_round);
       for (int i = 0; i < FLAGS_round; ++i) {
         std::unique_ptr<port::Logger> info_log;
         std::unique_ptr<port::MallocLogger> malloc_logger;
@@ -493,6 +497,7 @@ bool RunModel(const std::string &model_name,
           } else {
             int64_t t1 = NowMicros();
             total_run_duration += (t1 - t0);
+            round_millis.push_back((t1 - t0) / 1000.0);
             if (mace_benchmark_op) {
               op_stat.StatMetadata(metadata);
             }
@@ -502,6 +507,28 @@ bool RunModel(const std::string &model_name,
       }
       model_run_millis = total_run_duration / 1000.0 / FLAGS_round;
       LOG(INFO) << "Average latency: " << model_run_millis << " ms";
+      // statistical summary so CI can gate on stable quantiles instead
+      // of a single thermally-noisy number
+      if (round_millis.size() > 1) {
+        std::sort(round_millis.begin(), round_millis.end());
+        const size_t n = round_millis.size();
+        double sum = 0;
+        for (double v : round_millis) {
+          sum += v;
+        }
+        const double mean = sum / n;
+        double var = 0;
+        for (double v : round_millis) {
+          var += (v - mean) * (v - mean);
+        }
+        const double stddev = std::sqrt(var / (n - 1));
+        LOG(INFO) << "Latency stats (ms): p50 " << round_millis[n / 2]
+                  << ", p90 " << round_millis[(n * 9) / 10]
+                  << ", min " << round_millis[0]
+                  << ", max " << round_millis[n - 1]
+                  << ", stddev " << stddev
+                  << ", cv " << (mean > 0 ? stddev / mean : 0);
+      }
     }
 
     for (size_t i = 0; i < output_count; ++i) {
@@ -0,0 +1,113 @@
+// Copyright 2020 The MACE Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MACE_UTILS_ARENA_H_
+#define MACE_UTILS_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "mace/utils/macros.h"
+
+namespace mace {
+namespace utils {
+
+// Chunked bump allocator for per-run transient allocations. Allocation
+// is pointer arithmetic, Reset() is O(1) and keeps the chunks for the
+// next run, so steady-state runs stop hitting malloc entirely. Not
+// thread-safe; callers serialize access (e.g. run under one lock or on
+// one thread).
+class Arena {
+ public:
+  explicit Arena(size_t chunk_size = kDefaultChunkSize)
+      : chunk_size_(chunk_size), current_chunk_(0) {}
+
+  void *Allocate(size_t bytes,
+                 size_t alignment = alignof(std::max_align_t)) {
+    for (; current_chunk_ < chunks_.size(); ++current_chunk_) {
+      Chunk &chunk = chunks_[current_chunk_];
+      size_t aligned = (chunk.used + alignment - 1) & ~(alignment - 1);
+      if (aligned + bytes <= chunk.capacity) {
+        chunk.used = aligned + bytes;
+        return chunk.data.get() + aligned;
+      }
+    }
+    size_t capacity = bytes > chunk_size_ ? bytes : chunk_size_;
+    chunks_.emplace_back(Chunk{
+        std::unique_ptr<uint8_t[]>(new uint8_t[capacity]), capacity, bytes});
+    current_chunk_ = chunks_.size() - 1;
+    return chunks_.back().data.get();
+  }
+
+  void Reset() {
+    for (Chunk &chunk : chunks_) {
+      chunk.used = 0;
+    }
+    current_chunk_ = 0;
+  }
+
+ private:
+  struct Chunk {
+    std::unique_ptr<uint8_t[]> data;
+    size_t capacity;
+    size_t used;
+  };
+
+  static constexpr size_t kDefaultChunkSize = 64 * 1024;
+
+  size_t chunk_size_;
+  size_t current_chunk_;
+  std::vector<Chunk> chunks_;
+
+  MACE_DISABLE_COPY_AND_ASSIGN(Arena);
+};
+
+// STL allocator adapter over Arena; deallocate is a no-op, the memory
+// comes back in one piece on Arena::Reset().
+template <typename T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+
+  explicit ArenaAllocator(Arena *arena) : arena_(arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U> &other)  // NOLINT(runtime/explicit)
+      : arena_(other.arena()) {}
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *, size_t) {}
+
+  Arena *arena() const { return arena_; }
+
+  bool operator==(const ArenaAllocator &other) const {
+    return arena_ == other.arena_;
+  }
+  bool operator!=(const ArenaAllocator &other) const {
+    return arena_ != other.arena_;
+  }
+
+ private:
+  Arena *arena_;
+};
+
+}  // namespace utils
+}  // namespace mace
+
+#endif  // MACE_UTILS_ARENA_H_
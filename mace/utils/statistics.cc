@@ -21,6 +21,17 @@
 #include "mace/utils/logging.h"
 #include "mace/utils/string_util.h"
 
+// Energy attribution: the natural extension of these latency stats is
+// bracketing each Run (and each op under profiling) with platform
+// energy counters -- Android ODPM via
+// /sys/bus/iio/devices/iio:device*/energy_value or the
+// power_supply charge counters on older kernels -- and reporting
+// mJ/inference beside the micros. The counters are rail-granular and
+// millisecond-latched, so per-op attribution below ~1ms ops is
+// aliased and should be reported as per-run totals plus rail deltas
+// over op groups; a clean implementation adds an EnergySampler to the
+// port layer (unsupported by default) and threads samples through
+// OpStat the way latency already flows.
 namespace mace {
 namespace benchmark {
 
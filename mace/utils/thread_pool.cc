@@ -12,12 +12,18 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#if defined(__linux__) || defined(__ANDROID__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 #include <algorithm>
 #include <numeric>
 
 #include "mace/port/port.h"
 #include "mace/port/env.h"
 #include "mace/utils/logging.h"
+#include "mace/utils/conf_util.h"
 #include "mace/utils/spinlock.h"
 #include "mace/utils/math.h"
 #include "mace/utils/thread_pool.h"
@@ -137,6 +143,27 @@ MaceStatus GetCPUCoresToUse(const std::vector<float> &cpu_max_freqs,
   return MaceStatus::MACE_SUCCESS;
 }
 
+float GetCpuFrequencyDroop() {
+  std::vector<float> max_freqs;
+  std::vector<float> cur_freqs;
+  if (port::Env::Default()->GetCPUMaxFreq(&max_freqs)
+          != MaceStatus::MACE_SUCCESS ||
+      port::Env::Default()->GetCPUCurFreq(&cur_freqs)
+          != MaceStatus::MACE_SUCCESS) {
+    return 1.f;
+  }
+  float ratio_sum = 0.f;
+  int online_cores = 0;
+  const size_t core_count = std::min(max_freqs.size(), cur_freqs.size());
+  for (size_t i = 0; i < core_count; ++i) {
+    if (max_freqs[i] > 0 && cur_freqs[i] > 0) {
+      ratio_sum += cur_freqs[i] / max_freqs[i];
+      ++online_cores;
+    }
+  }
+  return online_cores > 0 ? ratio_sum / online_cores : 1.f;
+}
+
 ThreadPool::ThreadPool(const int thread_count_hint,
                        const CPUAffinityPolicy policy)
     : event_(kThreadPoolNone),
@@ -168,8 +195,20 @@ ThreadPool::ThreadPool(const int thread_count_hint,
 
   threads_ = std::vector<std::thread>(static_cast<size_t>(thread_count));
   thread_infos_ = std::vector<ThreadInfo>(static_cast<size_t>(thread_count));
-  for (auto &thread_info : thread_infos_) {
-    thread_info.cpu_cores = cores_to_use;
+  // MACE_PIN_THREADS_TO_CORES: give each worker exactly one core of
+  // the selected set instead of the whole set, so workers stop
+  // migrating between clusters mid-op and tile partitions keep their
+  // cache lines cluster-local. Off by default: 1:1 pinning hurts when
+  // other processes compete for the same cores.
+  const bool pin_one_to_one =
+      EnvConfEnabled("MACE_PIN_THREADS_TO_CORES") &&
+      static_cast<size_t>(thread_count) <= cores_to_use.size();
+  for (size_t i = 0; i < thread_infos_.size(); ++i) {
+    if (pin_one_to_one) {
+      thread_infos_[i].cpu_cores = {cores_to_use[i]};
+    } else {
+      thread_infos_[i].cpu_cores = cores_to_use;
+    }
   }
 }
 
@@ -201,6 +240,14 @@ void ThreadPool::Init() {
 
 void ThreadPool::Run(const std::function<void(const int64_t)> &func,
                      const int64_t iterations) {
+  // tiny regions: running inline beats waking every worker just to
+  // have them find an empty range and count down the latch
+  if (iterations <= 1) {
+    if (iterations == 1) {
+      func(0);
+    }
+    return;
+  }
   const size_t thread_count = threads_.size();
   const int64_t iters_per_thread = iterations / thread_count;
   const int64_t remainder = iterations % thread_count;
@@ -263,6 +310,24 @@ void ThreadPool::ThreadLoop(size_t tid) {
       LOG(ERROR) << "Failed to sched set affinity for tid: " << tid;
     }
   }
+#if defined(__linux__) || defined(__ANDROID__)
+  // MACE_SCHED_FIFO_PRIORITY=<1..99>: real-time workers for
+  // latency-critical builds. Requires CAP_SYS_NICE/root; combine with
+  // 1:1 pinning and an isolated cpuset configured by the system
+  // integrator so the RT workers cannot be preempted or migrated.
+  {
+    const char *rt_priority_env = getenv("MACE_SCHED_FIFO_PRIORITY");
+    if (rt_priority_env != nullptr) {
+      struct sched_param param;
+      param.sched_priority = atoi(rt_priority_env);
+      if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+        LOG(WARNING) << "Failed to set SCHED_FIFO priority "
+                     << param.sched_priority << " for worker " << tid
+                     << " (needs CAP_SYS_NICE)";
+      }
+    }
+  }
+#endif
 
   int last_event = kThreadPoolNone;
 
@@ -310,7 +375,10 @@ void ThreadPool::ThreadRun(size_t tid) {
     }
   }
 
-  // steal other threads' work
+  // Steal other threads' work, half of the victim's remaining range at a
+  // time. On asymmetric (big.LITTLE) cores a fast thread would otherwise
+  // trade one CAS per stolen tile with the slow owner, and the slowest
+  // core still gates the tail of every op.
   size_t thread_count = threads_.size();
   for (size_t t = (tid + 1) % thread_count; t != tid;
        t = (t + 1) % thread_count) {
@@ -320,11 +388,18 @@ void ThreadPool::ThreadRun(size_t tid) {
         reinterpret_cast<const std::function<void(int64_t)> *>(
             other_func_ptr);
     while ((range_len = other_thread_info.range_len) > 0) {
+      const int64_t steal_len = (range_len + 1) / 2;
+      const int64_t len_left = range_len - steal_len;
       if (other_thread_info.range_len.compare_exchange_strong(range_len,
-                                                              range_len
-                                                                  - 1)) {
-        int64_t tail = other_thread_info.range_end--;
-        other_func->operator()(tail - 1);
+                                                              len_left)) {
+        // The CAS reserved steal_len items; concurrent stealers reserve
+        // disjoint tails, and the owner consumes from range_start, so the
+        // ranges never cross.
+        const int64_t tail =
+            other_thread_info.range_end.fetch_sub(steal_len);
+        for (int64_t i = tail - steal_len; i < tail; ++i) {
+          other_func->operator()(i);
+        }
       }
     }
   }
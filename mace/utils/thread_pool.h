@@ -34,6 +34,13 @@ MaceStatus GetCPUCoresToUse(const std::vector<float> &cpu_max_freqs,
                             int *thread_count_hint,
                             std::vector<size_t> *cores);
 
+// Ratio of current to maximum CPU frequency averaged over online cores
+// (1.0 at peak clocks, lower when the SoC throttles). Sustained-load
+// clients poll this to detect thermal droop and re-tune work-group
+// sizes or shed threads; returns 1.0 when the platform exposes no
+// current-frequency interface.
+float GetCpuFrequencyDroop();
+
 class ThreadPool {
  public:
   ThreadPool(const int thread_count,
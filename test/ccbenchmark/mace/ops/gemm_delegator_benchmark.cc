@@ -0,0 +1,91 @@
+// Copyright 2020 The MACE Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Drives the Gemm delegator kernel directly, without op dispatch or
+// graph machinery, so micro-kernel regressions are visible above the
+// runtime noise. The logged GFLOPS next to the device's peak gives the
+// roofline position of each shape.
+
+#include <string>
+
+#include "mace/benchmark_utils/test_benchmark.h"
+#include "mace/core/ops/op_context.h"
+#include "mace/ops/delegator/gemm.h"
+#include "mace/ops/ops_test_util.h"
+
+namespace mace {
+namespace ops {
+namespace test {
+
+namespace {
+void GemmDelegatorBenchmark(int iters,
+                            int rows, int depth, int cols) {
+  mace::testing::StopTiming();
+
+  OpsTestNet net;
+  Device *device = OpTestContext::Get()->GetDevice(DeviceType::CPU);
+  OpContext context(net.ws(), device);
+
+  net.AddRandomInput<DeviceType::CPU, float>(
+      "LHS", {1, rows, depth});
+  net.AddRandomInput<DeviceType::CPU, float>(
+      "RHS", {1, depth, cols});
+  Tensor *output = net.ws()->CreateTensor(
+      "Output", device->allocator(), DataTypeToEnum<float>::v());
+  output->Resize({1, rows, cols});
+
+  auto gemm = delegator::Gemm::Create(
+      net.ws(),
+      MACE_DELEGATOR_KEY(Gemm, DeviceType::CPU, float, kCpuImplType),
+      delegator::GemmParam());
+
+  const Tensor *lhs = net.ws()->GetTensor("LHS");
+  const Tensor *rhs = net.ws()->GetTensor("RHS");
+
+  // Warm-up (also performs the first-run packing)
+  for (int i = 0; i < 2; ++i) {
+    gemm->Compute(&context, lhs, rhs, 1, rows, cols, depth,
+                  RowMajor, RowMajor, RowMajor, false, false, output);
+  }
+
+  const int64_t macs_per_iter =
+      static_cast<int64_t>(rows) * depth * cols;
+  mace::testing::MacsProcessed(iters * macs_per_iter);
+  mace::testing::StartTiming();
+  while (iters--) {
+    gemm->Compute(&context, lhs, rhs, 1, rows, cols, depth,
+                  RowMajor, RowMajor, RowMajor, false, false, output);
+  }
+}
+}  // namespace
+
+#define MACE_BM_GEMM_DELEGATOR(M, K, N)                             \
+  static void MACE_BM_GEMM_DELEGATOR_##M##_##K##_##N(int iters) {   \
+    GemmDelegatorBenchmark(iters, M, K, N);                         \
+  }                                                                 \
+  MACE_BENCHMARK(MACE_BM_GEMM_DELEGATOR_##M##_##K##_##N)
+
+// pointwise-conv shaped
+MACE_BM_GEMM_DELEGATOR(196, 128, 128);
+MACE_BM_GEMM_DELEGATOR(196, 256, 256);
+MACE_BM_GEMM_DELEGATOR(784, 64, 128);
+// fully-connected shaped
+MACE_BM_GEMM_DELEGATOR(1, 1024, 1000);
+// attention shaped
+MACE_BM_GEMM_DELEGATOR(64, 64, 64);
+MACE_BM_GEMM_DELEGATOR(256, 64, 256);
+
+}  // namespace test
+}  // namespace ops
+}  // namespace mace
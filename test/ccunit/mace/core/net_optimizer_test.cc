@@ -0,0 +1,172 @@
+// Copyright 2020 The MACE Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "mace/core/net_optimizer.h"
+
+namespace mace {
+namespace {
+
+void SetIntArg(OperatorDef *op, const std::string &name, int value) {
+  Argument *arg = op->add_arg();
+  arg->set_name(name);
+  arg->set_i(value);
+}
+
+void SetStrArg(OperatorDef *op, const std::string &name,
+               const std::string &value) {
+  Argument *arg = op->add_arg();
+  arg->set_name(name);
+  arg->set_s(value);
+}
+
+OperatorDef *AddOp(NetDef *net_def,
+                   const std::string &name,
+                   const std::string &type,
+                   const std::vector<std::string> &inputs,
+                   const std::vector<std::string> &outputs,
+                   DeviceType device = DeviceType::CPU) {
+  OperatorDef *op = net_def->add_op();
+  op->set_name(name);
+  op->set_type(type);
+  op->set_device_type(device);
+  for (auto &input : inputs) {
+    op->add_input(input);
+  }
+  for (auto &output : outputs) {
+    op->add_output(output);
+  }
+  return op;
+}
+
+void SetOutputShape(OperatorDef *op, const std::vector<int64_t> &dims) {
+  OutputShape *shape = op->add_output_shape();
+  for (int64_t dim : dims) {
+    shape->add_dims(dim);
+  }
+}
+
+void AddConstTensor(NetDef *net_def, const std::string &name,
+                    const std::vector<int64_t> &dims) {
+  ConstTensor *tensor = net_def->add_tensors();
+  tensor->set_name(name);
+  for (int64_t dim : dims) {
+    tensor->add_dims(dim);
+  }
+}
+
+NetDef MakeResidualNet(const std::vector<int64_t> &residual_dims) {
+  NetDef net_def;
+  AddConstTensor(&net_def, "residual", residual_dims);
+  OperatorDef *conv = AddOp(&net_def, "conv", "Conv2D",
+                            {"input", "filter", "bias"}, {"conv_out"});
+  SetOutputShape(conv, {1, 8, 4, 4});
+  OperatorDef *add = AddOp(&net_def, "add", "Eltwise",
+                           {"conv_out", "residual"}, {"add_out"});
+  SetIntArg(add, "type", 0);  // EltwiseType::SUM
+  AddOp(&net_def, "consumer", "Softmax", {"add_out"}, {"output"});
+  return net_def;
+}
+
+TEST(NetOptimizerTest, FuseResidualBlockMatchingShape) {
+  NetDef net_def = MakeResidualNet({1, 8, 4, 4});
+  NetOptimizer optimizer;
+  optimizer.FuseResidualBlocks(&net_def);
+
+  ASSERT_EQ(2, net_def.op_size());
+  const OperatorDef &conv = net_def.op(0);
+  EXPECT_EQ("Conv2D", conv.type());
+  ASSERT_EQ(4, conv.input_size());
+  EXPECT_EQ("residual", conv.input(3));
+  EXPECT_EQ("add_out", conv.output(0));
+}
+
+TEST(NetOptimizerTest, SkipBroadcastResidual) {
+  // per-channel broadcast SUM must keep its own Eltwise
+  NetDef net_def = MakeResidualNet({8});
+  NetOptimizer optimizer;
+  optimizer.FuseResidualBlocks(&net_def);
+
+  ASSERT_EQ(3, net_def.op_size());
+  EXPECT_EQ(3, net_def.op(0).input_size());
+  EXPECT_EQ("Eltwise", net_def.op(1).type());
+}
+
+TEST(NetOptimizerTest, FusePointwiseActivation) {
+  NetDef net_def;
+  OperatorDef *eltwise = AddOp(&net_def, "add", "Eltwise", {"a", "b"},
+                               {"add_out"}, DeviceType::GPU);
+  SetIntArg(eltwise, "type", 0);
+  OperatorDef *relu = AddOp(&net_def, "relu", "Activation", {"add_out"},
+                            {"relu_out"}, DeviceType::GPU);
+  SetStrArg(relu, "activation", "RELU");
+
+  NetOptimizer optimizer;
+  optimizer.FusePointwiseActivations(&net_def);
+
+  ASSERT_EQ(1, net_def.op_size());
+  const OperatorDef &fused = net_def.op(0);
+  EXPECT_EQ("Eltwise", fused.type());
+  EXPECT_EQ("relu_out", fused.output(0));
+  bool found_activation = false;
+  for (const auto &arg : fused.arg()) {
+    found_activation = found_activation ||
+        (arg.name() == "activation" && arg.s() == "RELU");
+  }
+  EXPECT_TRUE(found_activation);
+}
+
+TEST(NetOptimizerTest, RewriteOneHotMatMulToGather) {
+  NetDef net_def;
+  AddConstTensor(&net_def, "weights", {1000, 64});
+  AddOp(&net_def, "one_hot", "OneHot", {"indices"}, {"one_hot_out"});
+  AddOp(&net_def, "matmul", "MatMul", {"one_hot_out", "weights"},
+        {"matmul_out"});
+
+  NetOptimizer optimizer;
+  optimizer.FuseOneHotMatMul(&net_def);
+
+  ASSERT_EQ(1, net_def.op_size());
+  const OperatorDef &gather = net_def.op(0);
+  EXPECT_EQ("Gather", gather.type());
+  ASSERT_EQ(2, gather.input_size());
+  EXPECT_EQ("weights", gather.input(0));
+  EXPECT_EQ("indices", gather.input(1));
+  EXPECT_EQ("matmul_out", gather.output(0));
+}
+
+TEST(NetOptimizerTest, InsertPrecisionCast) {
+  NetDef net_def;
+  OperatorDef *producer = AddOp(&net_def, "producer", "Conv2D",
+                                {"input", "filter"}, {"bf16_out"});
+  SetIntArg(producer, "T", static_cast<int>(DT_BFLOAT16));
+  OperatorDef *consumer = AddOp(&net_def, "consumer", "Softmax",
+                                {"bf16_out"}, {"output"});
+  SetIntArg(consumer, "T", static_cast<int>(DT_FLOAT));
+
+  NetOptimizer optimizer;
+  optimizer.InsertPrecisionCasts(&net_def);
+
+  ASSERT_EQ(3, net_def.op_size());
+  const OperatorDef &cast = net_def.op(1);
+  EXPECT_EQ("Cast", cast.type());
+  EXPECT_EQ("bf16_out", cast.input(0));
+  EXPECT_EQ(cast.output(0), net_def.op(2).input(0));
+}
+
+}  // namespace
+}  // namespace mace
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstdlib>
+
 #include "mace/libmace/mace_api_test.h"
 
 namespace mace {
@@ -85,6 +87,80 @@ void MaceRun(const int in_out_size,
   CheckOutputs<D, T>(*net_def, inputs, outputs, data);
 }
 
+// Pipelined RunAsync must produce exactly what a synchronous Run does,
+// including the input layout transform performed on staging tensors.
+template <typename T>
+void PipelinedMaceRun(const std::vector<int64_t> &shape,
+                      const std::vector<int64_t> &filter_shape) {
+  std::vector<std::string> input_names = {"input0"};
+  std::vector<std::string> output_names = {"output0"};
+  std::string filter_tensor_name = "filter";
+
+  std::shared_ptr<NetDef> net_def(new NetDef());
+
+  std::vector<T> data;
+  ops::test::GenerateRandomRealTypeData<T>(filter_shape, &data);
+  AddTensor<T>(filter_tensor_name, filter_shape, 0, data.size(), net_def.get());
+
+  InputOutputInfo *info = net_def->add_input_info();
+  info->set_data_format(static_cast<int>(DataFormat::NHWC));
+  info->set_name(input_names[0]);
+  for (auto d : shape) {
+    info->add_dims(static_cast<int>(d));
+  }
+  net_def->add_output_info()->set_name(output_names[0]);
+  Conv3x3<T>(input_names[0], filter_tensor_name, output_names[0], shape,
+             net_def.get());
+
+  MaceEngineConfig config(DeviceType::CPU);
+
+  std::map<std::string, mace::MaceTensor> inputs;
+  std::map<std::string, mace::MaceTensor> sync_outputs;
+  std::map<std::string, mace::MaceTensor> pipelined_outputs;
+  GenerateInputs(input_names, shape, &inputs);
+  GenerateOutputs(output_names, shape, &sync_outputs);
+  GenerateOutputs(output_names, shape, &pipelined_outputs);
+
+  {
+    MaceEngine engine(config);
+    MaceStatus status = engine.Init(
+        net_def.get(), input_names, output_names,
+        reinterpret_cast<unsigned char *>(data.data()),
+        data.size() * sizeof(T));
+    EXPECT_EQ(status, MaceStatus::MACE_SUCCESS);
+    engine.Run(inputs, &sync_outputs);
+    CheckOutputs<DeviceType::CPU, T>(*net_def, inputs, sync_outputs, data);
+  }
+
+  setenv("MACE_ENABLE_PIPELINE", "1", 1);
+  {
+    MaceEngine engine(config);
+    MaceStatus status = engine.Init(
+        net_def.get(), input_names, output_names,
+        reinterpret_cast<unsigned char *>(data.data()),
+        data.size() * sizeof(T));
+    EXPECT_EQ(status, MaceStatus::MACE_SUCCESS);
+    // run twice so both staging slots get exercised
+    for (int i = 0; i < 2; ++i) {
+      auto future = engine.RunAsync(inputs, &pipelined_outputs);
+      EXPECT_EQ(future.get(), MaceStatus::MACE_SUCCESS);
+    }
+    CheckOutputs<DeviceType::CPU, T>(*net_def, inputs, pipelined_outputs,
+                                     data);
+  }
+  unsetenv("MACE_ENABLE_PIPELINE");
+
+  const int64_t output_size =
+      std::accumulate(shape.begin(), shape.end(), 1,
+                      std::multiplies<int64_t>());
+  const float *sync_data = sync_outputs[output_names[0]].data().get();
+  const float *pipelined_data =
+      pipelined_outputs[output_names[0]].data().get();
+  for (int64_t i = 0; i < output_size; ++i) {
+    EXPECT_NEAR(sync_data[i], pipelined_data[i], 1e-6) << "index " << i;
+  }
+}
+
 }  // namespace
 
 TEST_F(MaceAPITest, SingleInputOutput) {
@@ -105,6 +181,10 @@ TEST_F(MaceAPITest, SingleInputOutput) {
                      {16, 16, 3, 3});
 }
 
+TEST_F(MaceAPITest, PipelinedRunAsyncMatchesRun) {
+  PipelinedMaceRun<float>({1, 32, 32, 16}, {16, 16, 3, 3});
+}
+
 TEST_F(MaceAPITest, MultipleInputOutput) {
   MaceRun<CPU, float>(2,
                       {1, 16, 32, 16},
@@ -0,0 +1,79 @@
+// Copyright 2020 The MACE Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mace/ops/ops_test_util.h"
+
+namespace mace {
+namespace ops {
+namespace test {
+
+class TopKOpTest : public OpsTestBase {};
+
+namespace {
+void TopKTest(const std::vector<index_t> &input_shape,
+              const std::vector<float> &input,
+              const int k,
+              const std::vector<index_t> &output_shape,
+              const std::vector<float> &expected_values,
+              const std::vector<int32_t> &expected_indices) {
+  OpsTestNet net;
+
+  // Add input data
+  net.AddInputFromArray<DeviceType::CPU, float>("Input", input_shape, input);
+
+  OpDefBuilder("TopK", "TopKTest")
+      .Input("Input")
+      .Output("Values")
+      .Output("Indices")
+      .AddIntArg("k", k)
+      .OutputType({DT_FLOAT, DT_INT32})
+      .Finalize(net.NewOperatorDef());
+  // Run
+  net.RunOp(DeviceType::CPU);
+
+  // Check
+  auto values = net.CreateTensor<float>(output_shape, expected_values);
+  ExpectTensorNear<float>(*values, *net.GetOutput("Values"), 1e-5);
+  auto indices = net.CreateTensor<int32_t>(output_shape, expected_indices);
+  ExpectTensorNear<int32_t>(*indices, *net.GetOutput("Indices"), 1e-5);
+}
+}  // namespace
+
+TEST_F(TopKOpTest, Vector) {
+  TopKTest({5}, {1, 5, 3, 4, 2}, 2, {2}, {5, 4}, {1, 3});
+}
+
+TEST_F(TopKOpTest, KLargerThanRow) {
+  // k is clamped to the row size
+  TopKTest({3}, {-3, -1, -2}, 5, {3}, {-1, -2, -3}, {1, 2, 0});
+}
+
+TEST_F(TopKOpTest, Matrix) {
+  TopKTest({2, 4},
+           {4, 9, 1, 7,
+            3, 3, 8, 2},
+           2,
+           {2, 2},
+           {9, 7, 8, 3},
+           {1, 3, 2, 0});
+}
+
+TEST_F(TopKOpTest, TiesAreStable) {
+  // equal values keep ascending index order
+  TopKTest({4}, {2, 7, 7, 2}, 3, {3}, {7, 7, 2}, {1, 2, 0});
+}
+
+}  // namespace test
+}  // namespace ops
+}  // namespace mace
@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
 #include <cstdlib>
+#include <thread>  // NOLINT(build/c++11)
 #include <vector>
 #include "mace/utils/thread_pool.h"
 
@@ -105,6 +108,39 @@ TEST_F(ThreadPoolTest, Compute3D) {
   }
 }
 
+TEST_F(ThreadPoolTest, Compute1DImbalancedStealing) {
+  // Early iterations are much slower than the rest, so fast workers
+  // must steal from the slow owner's tail; every index still has to be
+  // visited exactly once whatever mix of owner/stealer executes it.
+  constexpr int64_t test_size = 256;
+  std::vector<std::atomic<int>> visits(test_size);
+  for (auto &v : visits) {
+    v = 0;
+  }
+  thread_pool.Compute1D([&](int64_t start, int64_t end, int64_t step) {
+    for (int64_t i = start; i < end; i += step) {
+      if (i < test_size / 8) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      ++visits[i];
+    }
+  }, 0, test_size, 1, 1 /* tile_size: one index per tile */);
+  for (int64_t i = 0; i < test_size; ++i) {
+    EXPECT_EQ(1, visits[i]) << "index " << i;
+  }
+}
+
+TEST_F(ThreadPoolTest, Compute1DSingleIteration) {
+  // single-tile regions run inline on the caller
+  int calls = 0;
+  thread_pool.Compute1D([&](int64_t start, int64_t end, int64_t step) {
+    for (int64_t i = start; i < end; i += step) {
+      ++calls;
+    }
+  }, 0, 1, 1);
+  EXPECT_EQ(1, calls);
+}
+
 }  // namespace
 }  // namespace utils
 }  // namespace mace